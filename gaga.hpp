@@ -23,14 +23,41 @@
 // before including this file,
 // #define OMP if you want OpenMP parallelisation
 // #define CLUSTER if you want MPI parallelisation
-// #define CLUSTER if you want MPI parallelisation
+// #define both for hybrid execution: one communicating rank per node feeding a
+// node-wide pool of OpenMP threads (see "HYBRID EVALUATION" in the GA class)
 #ifdef CLUSTER
 #include <mpi.h>
+#include <atomic>
 #include <cstring>
 #endif
 #ifdef OMP
 #include <omp.h>
 #endif
+// #define SOCKET_WORKERS if you want to distribute evaluations to worker processes
+// through TCP or Unix sockets (POSIX only)
+#ifdef SOCKET_WORKERS
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+// #define ZLIB to be able to compress the per individual stats (link with -lz)
+#ifdef ZLIB
+#include <zlib.h>
+#endif
+// #define TRACING to record a trace of the main phases of each generation (see TRACING)
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <experimental/filesystem>
 namespace fs = std::experimental::filesystem;
@@ -41,14 +68,29 @@ namespace fs = std::experimental::filesystem;
 
 #include <assert.h>
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <deque>
+#include <exception>
+#include <list>
 #include <fstream>
+#include <iomanip>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <random>
+#include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <cstring>
 #include <unordered_map>
 #include <unordered_set>
@@ -126,6 +168,488 @@ using std::chrono::system_clock;
 // #define OMP if you want OpenMP parallelisation
 // #define CLUSTER if you want MPI parallelisation
 
+/*****************************************************************************
+ *                         BINARY SERIALIZATION
+ * **************************************************************************/
+// Helpers for the compact binary codecs. Values are written in native byte order, and
+// strings are prefixed by their size: both ends must run on the same architecture.
+template <typename T> void binaryPut(string &out, const T &v) {
+    static_assert(std::is_trivially_copyable<T>::value, "binaryPut needs a trivial type");
+    out.append(reinterpret_cast<const char *>(&v), sizeof(T));
+}
+inline void binaryPut(string &out, const string &str) {
+    binaryPut(out, static_cast<uint64_t>(str.size()));
+    out.append(str);
+}
+template <typename T> T binaryGet(const char *&cur, const char *end) {
+    if (static_cast<size_t>(end - cur) < sizeof(T))
+        throw std::runtime_error("Truncated binary data");
+    T v;
+    std::memcpy(&v, cur, sizeof(T));
+    cur += sizeof(T);
+    return v;
+}
+inline string binaryGetString(const char *&cur, const char *end) {
+    auto size = binaryGet<uint64_t>(cur, end);
+    if (static_cast<uint64_t>(end - cur) < size)
+        throw std::runtime_error("Truncated binary data");
+    string str(cur, size);
+    cur += size;
+    return str;
+}
+// binaryGet for generic code: reads what binaryPut wrote for v's type
+template <typename T> void binaryRead(const char *&cur, const char *end, T &v) {
+    v = binaryGet<T>(cur, end);
+}
+inline void binaryRead(const char *&cur, const char *end, string &str) {
+    str = binaryGetString(cur, end);
+}
+
+/*****************************************************************************
+ *                                 TRACING
+ * **************************************************************************/
+// GAGA_TRACE_SPAN(name) records the duration of the enclosing scope (evaluation, MPI
+// exchanges, novelty, sorting, breeding, saves...) when gaga is built with TRACING, and
+// compiles to nothing otherwise. A span costs two clock reads and an append to a buffer
+// owned by the calling thread (no lock). Spans are written as Chrome trace events
+// (chrome://tracing, ui.perfetto.dev): one complete ("X") event per span, with the MPI rank
+// as pid and a tracer specific thread id as tid. name must be a string literal.
+class Tracer {
+ public:
+    using clock = std::chrono::steady_clock;
+
+    static Tracer &get() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    void setRank(int r) { rank = r; }
+    void record(const char *name, clock::time_point start, clock::time_point end) {
+        threadBuffer().spans.push_back({name, start, end});
+    }
+    // names the calling thread in the trace
+    void setThreadName(const string &name) { threadBuffer().name = name; }
+
+    // Events of this process, comma separated. No span must be recorded meanwhile.
+    string events() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3);
+        out << R"({"name":"process_name","ph":"M","pid":)" << rank
+            << R"(,"tid":0,"args":{"name":"rank )" << rank << R"("}})";
+        for (size_t t = 0; t < buffers.size(); ++t) {
+            const auto &b = *buffers[t];
+            if (!b.name.empty())
+                out << R"(,{"name":"thread_name","ph":"M","pid":)" << rank << ",\"tid\":" << t
+                    << R"(,"args":{"name":)" << json(b.name).dump() << "}}";
+            for (const auto &s : b.spans)
+                out << ",{\"name\":" << json(s.name).dump() << R"(,"ph":"X","pid":)" << rank
+                    << ",\"tid\":" << t << ",\"ts\":" << micros(s.start)
+                    << ",\"dur\":"
+                    << std::chrono::duration<double, std::micro>(s.end - s.start).count() << "}";
+        }
+        return out.str();
+    }
+    // Trace document made of the events of one or several processes
+    static void writeDocument(std::ostream &out, const vector<string> &events) {
+        out << R"({"displayTimeUnit":"ms","traceEvents":[)";
+        bool first = true;
+        for (const auto &e : events) {
+            if (e.empty()) continue;  // e.g. a lost rank
+            out << (first ? "" : ",") << e;
+            first = false;
+        }
+        out << "]}";
+    }
+    void write(const string &path) const {
+        std::ofstream file(path);
+        writeDocument(file, {events()});
+        if (!file) throw std::runtime_error("Cannot write " + path);
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t n = 0;
+        for (const auto &b : buffers) n += b->spans.size();
+        return n;
+    }
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto &b : buffers) b->spans.clear();
+    }
+
+ protected:
+    struct Span {
+        const char *name;
+        clock::time_point start, end;
+    };
+    struct ThreadBuffer {
+        string name;
+        vector<Span> spans;
+    };
+    mutable std::mutex mutex;  // guards buffers (not their content)
+    vector<std::unique_ptr<ThreadBuffer>> buffers;
+    int rank = 0;
+    // timestamps are wall clock microseconds, so that the ranks' traces line up
+    const clock::time_point epoch = clock::now();
+    const double wallEpoch =
+        std::chrono::duration<double, std::micro>(system_clock::now().time_since_epoch())
+            .count();
+
+    Tracer() {}
+    double micros(clock::time_point t) const {
+        return wallEpoch + std::chrono::duration<double, std::micro>(t - epoch).count();
+    }
+    ThreadBuffer &threadBuffer() {
+        thread_local ThreadBuffer *buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(mutex);
+            buffers.emplace_back(new ThreadBuffer);
+            buffer = buffers.back().get();
+            buffer->spans.reserve(1024);
+        }
+        return *buffer;
+    }
+};
+
+class TraceSpan {
+ public:
+    explicit TraceSpan(const char *n) : name(n), start(Tracer::clock::now()) {}
+    ~TraceSpan() { Tracer::get().record(name, start, Tracer::clock::now()); }
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+ private:
+    const char *name;
+    Tracer::clock::time_point start;
+};
+
+#ifdef TRACING
+#define GAGA_TRACE_CONCAT_(a, b) a##b
+#define GAGA_TRACE_CONCAT(a, b) GAGA_TRACE_CONCAT_(a, b)
+#define GAGA_TRACE_SPAN(name) ::GAGA::TraceSpan GAGA_TRACE_CONCAT(gagaSpan, __LINE__)(name)
+#else
+#define GAGA_TRACE_SPAN(name)
+#endif
+
+/*****************************************************************************
+ *                           RANDOM NUMBERS
+ * **************************************************************************/
+// splitmix64 finalizer: spreads structured values (counters, indices) over 64 bits
+inline uint64_t mixSeed(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// xoshiro256** (Blackman & Vigna): small, fast, and jump() moves it 2^128 draws ahead,
+// which splits one seed into non overlapping substreams. Usable with the <random>
+// distributions.
+class Xoshiro256 {
+ public:
+    using result_type = uint64_t;
+    using State = std::array<uint64_t, 4>;
+
+    explicit Xoshiro256(uint64_t s = 0) { seed(s); }
+
+    // the state is expanded from the seed with splitmix64, as recommended by the authors
+    void seed(uint64_t s) {
+        for (size_t i = 0; i < 4; ++i) state[i] = mixSeed(s + i * 0x9e3779b97f4a7c15ULL);
+    }
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // equivalent to 2^128 (resp. 2^192) calls
+    void jump() {
+        jump({{0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL,
+               0x39abdc4529b1661cULL}});
+    }
+    void longJump() {
+        jump({{0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL,
+               0x39109bb02acbe635ULL}});
+    }
+
+    const State &getState() const { return state; }
+    void setState(const State &s) { state = s; }
+    bool operator==(const Xoshiro256 &o) const { return state == o.state; }
+    bool operator!=(const Xoshiro256 &o) const { return state != o.state; }
+
+ protected:
+    State state;
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    void jump(const State &poly) {
+        State s{{0, 0, 0, 0}};
+        for (auto p : poly) {
+            for (int b = 0; b < 64; ++b) {
+                if (p & (1ULL << b))
+                    for (size_t i = 0; i < 4; ++i) s[i] ^= state[i];
+                (*this)();
+            }
+        }
+        state = s;
+    }
+};
+using RandomEngine = Xoshiro256;
+
+// Random number service of a GA. Every stream is a function of the seed and of its
+// coordinates only, so runs can be reproduced, and resumed from a saved state:
+// - stream(a, b): independent stream for e.g. (generation, offspring slot)
+// - threadStream(t): t-th substream of the main engine, 2^128 draws away from the others
+// - engine(): the main engine, for serial uses (e.g. the initial population)
+class RandomStreams {
+ public:
+    explicit RandomStreams(uint64_t s = 0) { setSeed(s); }
+
+    void setSeed(uint64_t s) {
+        seed = s;
+        mainEngine.seed(s);
+    }
+    uint64_t getSeed() const { return seed; }
+
+    RandomEngine stream(uint64_t a, uint64_t b) const {
+        return RandomEngine(mixSeed(seed ^ mixSeed(a ^ mixSeed(b))));
+    }
+    RandomEngine threadStream(size_t t) const {
+        RandomEngine e = mainEngine;
+        for (size_t i = 0; i <= t; ++i) e.jump();
+        return e;
+    }
+    RandomEngine &engine() { return mainEngine; }
+
+    json toJSON() const {
+        json o;
+        const auto &s = mainEngine.getState();
+        o["seed"] = seed;
+        o["state"] = vector<uint64_t>(s.begin(), s.end());
+        return o;
+    }
+    void fromJSON(const json &o) {
+        seed = o.at("seed").get<uint64_t>();
+        auto v = o.at("state").get<vector<uint64_t>>();
+        if (v.size() != 4) throw std::invalid_argument("Invalid random engine state");
+        mainEngine.setState({{v[0], v[1], v[2], v[3]}});
+    }
+
+ protected:
+    uint64_t seed = 0;
+    RandomEngine mainEngine;
+};
+
+/*****************************************************************************
+ *                           DNA OPERATORS
+ * **************************************************************************/
+// The GA calls the DNA operators through these, so that a DNA can opt into:
+// - receiving the random stream of the offspring it is building:
+//     void mutate(RandomEngine &), DNA crossover(const DNA &, RandomEngine &),
+//     void crossover(const DNA &, DNA &child0, DNA &child1, RandomEngine &)
+// - writing a crossover's offspring into an existing DNA whose storage can be reused (see
+//   GA::recycledSlot): void crossoverInto(const DNA &other, DNA &child [, RandomEngine &])
+//   and void crossoverInto(const DNA &other, DNA &child0, DNA &child1 [, RandomEngine &]).
+//   The children then hold the DNA of a retired individual, which must be overwritten.
+// Operators without the engine are used when these are not available. Without
+// crossoverInto, children are fresh: returned by crossover, or default constructed
+// before being passed to crossover(other, child0, child1).
+template <int N> struct OverloadPriority : OverloadPriority<N - 1> {};
+template <> struct OverloadPriority<0> {};
+
+template <typename D>
+auto dnaMutate(D &d, RandomEngine &rng, OverloadPriority<1>) -> decltype(d.mutate(rng), void()) {
+    d.mutate(rng);
+}
+template <typename D> void dnaMutate(D &d, RandomEngine &, OverloadPriority<0>) { d.mutate(); }
+template <typename D> void dnaMutate(D &d, RandomEngine &rng) {
+    dnaMutate(d, rng, OverloadPriority<1>());
+}
+
+template <typename D>
+auto dnaCrossoverInto(D &p0, const D &p1, D &child, RandomEngine &rng, OverloadPriority<3>)
+    -> decltype(p0.crossoverInto(p1, child, rng), void()) {
+    p0.crossoverInto(p1, child, rng);
+}
+template <typename D>
+auto dnaCrossoverInto(D &p0, const D &p1, D &child, RandomEngine &, OverloadPriority<2>)
+    -> decltype(p0.crossoverInto(p1, child), void()) {
+    p0.crossoverInto(p1, child);
+}
+template <typename D>
+auto dnaCrossoverInto(D &p0, const D &p1, D &child, RandomEngine &rng, OverloadPriority<1>)
+    -> decltype(child = p0.crossover(p1, rng), void()) {
+    child = p0.crossover(p1, rng);
+}
+template <typename D>
+void dnaCrossoverInto(D &p0, const D &p1, D &child, RandomEngine &, OverloadPriority<0>) {
+    child = p0.crossover(p1);
+}
+template <typename D> void dnaCrossoverInto(D &p0, const D &p1, D &child, RandomEngine &rng) {
+    dnaCrossoverInto(p0, p1, child, rng, OverloadPriority<3>());
+}
+
+template <typename D>
+auto dnaCrossover(D &p0, const D &p1, D &c0, D &c1, RandomEngine &rng, OverloadPriority<3>)
+    -> decltype(p0.crossoverInto(p1, c0, c1, rng), void()) {
+    p0.crossoverInto(p1, c0, c1, rng);
+}
+template <typename D>
+auto dnaCrossover(D &p0, const D &p1, D &c0, D &c1, RandomEngine &, OverloadPriority<2>)
+    -> decltype(p0.crossoverInto(p1, c0, c1), void()) {
+    p0.crossoverInto(p1, c0, c1);
+}
+template <typename D>
+auto dnaCrossover(D &p0, const D &p1, D &c0, D &c1, RandomEngine &rng, OverloadPriority<1>)
+    -> decltype(p0.crossover(p1, c0, c1, rng), void()) {
+    c0 = D();
+    c1 = D();
+    p0.crossover(p1, c0, c1, rng);
+}
+template <typename D>
+void dnaCrossover(D &p0, const D &p1, D &c0, D &c1, RandomEngine &, OverloadPriority<0>) {
+    c0 = D();
+    c1 = D();
+    p0.crossover(p1, c0, c1);
+}
+template <typename D> void dnaCrossover(D &p0, const D &p1, D &c0, D &c1, RandomEngine &rng) {
+    dnaCrossover(p0, p1, c0, c1, rng, OverloadPriority<3>());
+}
+
+/*****************************************************************************
+ *                         COPY ON WRITE DNA
+ * **************************************************************************/
+// Opt-in wrapper for big DNA types: GA<SharedDNA<MyDNA>> instead of GA<MyDNA>. Copies of a
+// SharedDNA (clones passed on to the next generation without crossover) share the same
+// MyDNA through reference counting, and the MyDNA is only copied when mutate() or reset()
+// needs write access to a shared body. If MyDNA has a "MyDNA cloneForMutation() const"
+// method, it is used for that copy instead of the copy constructor (e.g. to share big
+// read-only parts and copy only what mutate() modifies).
+// crossover is called on the shared bodies, so it must not modify the parents' genomes.
+template <typename T, typename = void> struct hasCloneForMutation : std::false_type {};
+template <typename T>
+struct hasCloneForMutation<T, decltype(void(std::declval<const T &>().cloneForMutation()))>
+    : std::true_type {};
+
+template <typename Body> class SharedDNA {
+ public:
+    SharedDNA() : body(std::make_shared<Body>()) {}
+    SharedDNA(const Body &b) : body(std::make_shared<Body>(b)) {}
+    SharedDNA(Body &&b) : body(std::make_shared<Body>(std::move(b))) {}
+    explicit SharedDNA(const string &s) : body(std::make_shared<Body>(s)) {}
+
+    void mutate() { write().mutate(); }
+    void reset() { write().reset(); }
+    SharedDNA crossover(const SharedDNA &other) { return SharedDNA(body->crossover(*other.body)); }
+    void crossover(const SharedDNA &other, SharedDNA &child0, SharedDNA &child1) {
+        child0.body = std::make_shared<Body>();
+        child1.body = std::make_shared<Body>();
+        body->crossover(*other.body, *child0.body, *child1.body);
+    }
+    // used by the GA: forward the random stream and reuse the children's bodies when
+    // they are not shared (see DNA OPERATORS)
+    void mutate(RandomEngine &rng) { dnaMutate(write(), rng); }
+    void crossoverInto(const SharedDNA &other, SharedDNA &child, RandomEngine &rng) {
+        dnaCrossoverInto(*body, *other.body, child.overwrite(), rng);
+    }
+    void crossoverInto(const SharedDNA &other, SharedDNA &child0, SharedDNA &child1,
+                       RandomEngine &rng) {
+        dnaCrossover(*body, *other.body, child0.overwrite(), child1.overwrite(), rng);
+    }
+    string serialize() const { return body->serialize(); }
+
+    // read access never copies
+    const Body &operator*() const { return *body; }
+    const Body *operator->() const { return body.get(); }
+    // write access detaches the body if it is shared
+    Body &write() {
+        if (body.use_count() > 1) body = std::make_shared<Body>(cloneBody(*body));
+        return *body;
+    }
+    bool isShared() const { return body.use_count() > 1; }
+
+ protected:
+    std::shared_ptr<Body> body;
+
+    // write access to a body that is about to be entirely overwritten: no copy needed
+    Body &overwrite() {
+        if (body.use_count() > 1) body = std::make_shared<Body>();
+        return *body;
+    }
+
+    template <typename B = Body>
+    static typename std::enable_if<hasCloneForMutation<B>::value, B>::type cloneBody(const B &b) {
+        return b.cloneForMutation();
+    }
+    template <typename B = Body>
+    static typename std::enable_if<!hasCloneForMutation<B>::value, const B &>::type cloneBody(
+        const B &b) {
+        return b;
+    }
+};
+
+/*****************************************************************************
+ *                         JSON POPULATION STREAMS
+ * **************************************************************************/
+// Streaming codec for json population documents ({..., "population": [individuals]}).
+// The writer dumps one individual per line, and the reader hands each individual over as
+// soon as it is parsed then drops it: the json lexer only buffers the current line, so
+// neither side ever holds the json tree (or the text) of a whole population.
+class PopulationJSONWriter {
+ public:
+    // header: the other fields of the document (evaluator, generation...)
+    explicit PopulationJSONWriter(std::ostream &o, const json &header = json::object())
+        : out(o) {
+        out << "{";
+        for (auto it = header.begin(); it != header.end(); ++it)
+            if (it.key() != "population") out << json(it.key()).dump() << ":" << it->dump() << ",";
+        out << "\"population\":[";
+    }
+
+    void write(const json &individual) {
+        if (nbWritten++) out << ",";
+        out << "\n" << individual.dump();
+    }
+
+    // ends the document, must be called once every individual is written
+    void close() { out << "\n]}"; }
+
+ protected:
+    std::ostream &out;
+    size_t nbWritten = 0;
+};
+
+// Parses a population document, calling onIndividual with each element of its
+// "population" array. Returns the other fields of the document.
+inline json readPopulationJSON(std::istream &in,
+                               const std::function<void(const json &)> &onIndividual) {
+    string topKey;
+    json::parser_callback_t cb = [&](int depth, json::parse_event_t event, json &parsed) {
+        if (event == json::parse_event_t::key && depth == 1) {
+            topKey = parsed.get<string>();
+        } else if (event == json::parse_event_t::object_end && depth == 2 &&
+                   topKey == "population") {
+            onIndividual(parsed);
+            return false;  // not kept in the document
+        }
+        return true;
+    };
+    json o = json::parse(in, cb);
+    if (!o.is_object() || !o.count("population"))
+        throw std::invalid_argument("Not a json population document");
+    o.erase("population");
+    return o;
+}
+
 /*****************************************************************************
  *                         INDIVIDUAL CLASS
  * **************************************************************************/
@@ -133,6 +657,7 @@ using std::chrono::system_clock;
 // DNA mutate()
 // DNA crossover(DNA& other)
 // void crossover(DNA other, DNA& child0, DNA& child1) -> for nsga2
+// (each can take a trailing RandomEngine&, see DNA OPERATORS)
 // static DNA random(int argc, char** argv)
 // json& constructor
 // void reset()
@@ -147,18 +672,15 @@ template <typename DNA> struct Individual {
     bool wasAlreadyEvaluated = false;
     double evalTime = 0.0;
 
-    // NSGA-II related stuff
-    std::vector<Individual*>    sp;
-    int                         np;
-    int                         paretoRank;
-    double                      crowdingDistance;
-
     Individual() {}
     explicit Individual(const DNA &d) : dna(d) {}
+    explicit Individual(DNA &&d) : dna(std::move(d)) {}
 
     explicit Individual(const json &o) {
         assert(o.count("dna"));
-        dna = DNA(o.at("dna").dump());
+        // dna is stored as the output of serialize(), i.e. usually as a json string
+        const auto &d = o.at("dna");
+        dna = DNA(d.is_string() ? d.get<string>() : d.dump());
         if (o.count("footprint")) footprint = o.at("footprint").get<fpType>();
         if (o.count("fitnesses")) fitnesses = o.at("fitnesses").get<decltype(fitnesses)>();
         if (o.count("infos")) infos = o.at("infos");
@@ -167,9 +689,24 @@ template <typename DNA> struct Individual {
         if (o.count("evalTime")) evalTime = o.at("evalTime");
     }
 
+    // Clears this individual so that it can be reused for a new offspring. Containers keep
+    // their capacity, and the dna is left untouched (it is overwritten by the caller).
+    // With keepFitnessEntries, fitnesses are left for the next evaluation to overwrite (see
+    // GA::enableFitnessRecycling).
+    void recycle(bool keepFitnessEntries = false) {
+        if (!keepFitnessEntries) fitnesses.clear();
+        footprint.clear();
+        infos.clear();
+        evaluated = false;
+        wasAlreadyEvaluated = false;
+        evalTime = 0.0;
+    }
+
     ~Individual() = default;
     Individual(const Individual&) = default;
+    Individual(Individual&&) = default;
     Individual& operator=(const Individual&) = default;
+    Individual& operator=(Individual&&) = default;
 
     // Exports individual to json
     json toJSON() const {
@@ -184,6 +721,52 @@ template <typename DNA> struct Individual {
         return o;
     }
 
+    // Binary codec, more compact and faster than json (used by the socket transport):
+    // [dna][nb fitnesses]([name][value])*[nb snapshots]([nb values][values])*[infos]
+    // [evaluated][wasAlreadyEvaluated][evalTime]
+    void toBinary(string &out) const {
+        binaryPut(out, dna.serialize());
+        binaryPut(out, static_cast<uint64_t>(fitnesses.size()));
+        for (const auto &f : fitnesses) {
+            binaryPut(out, f.first);
+            binaryPut(out, f.second);
+        }
+        binaryPut(out, static_cast<uint64_t>(footprint.size()));
+        for (const auto &snapshot : footprint) {
+            binaryPut(out, static_cast<uint64_t>(snapshot.size()));
+            out.append(reinterpret_cast<const char *>(snapshot.data()),
+                       snapshot.size() * sizeof(double));
+        }
+        binaryPut(out, infos);
+        binaryPut(out, static_cast<uint8_t>(evaluated));
+        binaryPut(out, static_cast<uint8_t>(wasAlreadyEvaluated));
+        binaryPut(out, evalTime);
+    }
+
+    // Reads an individual written by toBinary, and moves cur after it
+    static Individual fromBinary(const char *&cur, const char *end) {
+        Individual ind(DNA(binaryGetString(cur, end)));
+        auto nbFit = binaryGet<uint64_t>(cur, end);
+        for (uint64_t i = 0; i < nbFit; ++i) {
+            auto name = binaryGetString(cur, end);
+            ind.fitnesses[name] = binaryGet<double>(cur, end);
+        }
+        ind.footprint.resize(binaryGet<uint64_t>(cur, end));
+        for (auto &snapshot : ind.footprint) {
+            snapshot.resize(binaryGet<uint64_t>(cur, end));
+            size_t bytes = snapshot.size() * sizeof(double);
+            if (static_cast<size_t>(end - cur) < bytes)
+                throw std::runtime_error("Truncated binary data");
+            std::memcpy(snapshot.data(), cur, bytes);
+            cur += bytes;
+        }
+        ind.infos = binaryGetString(cur, end);
+        ind.evaluated = binaryGet<uint8_t>(cur, end) != 0;
+        ind.wasAlreadyEvaluated = binaryGet<uint8_t>(cur, end) != 0;
+        ind.evalTime = binaryGet<double>(cur, end);
+        return ind;
+    }
+
     // Exports a vector of individual to json
     static json popToJSON(const vector<Individual<DNA>> &p) {
         json o;
@@ -201,136 +784,2272 @@ template <typename DNA> struct Individual {
         for (auto &ind : popArray) res.push_back(Individual<DNA>(ind));
         return res;
     }
-};
-
-/*********************************************************************************
- *                                 GA CLASS
- ********************************************************************************/
-// DNA requirements : see Individual class;
-//
-// Evaluaor class requirements (see examples folder):
-// constructor(int argc, char** argv)
-// void operator()(const Individual<DNA>& ind)
-// const string name
-//
-// TYPICAL USAGE :
-//
-// GA<DNAType, EvalType> ga;
-// ga.setPopSize(400);
-// return ga.start();
-
-enum class SelectionMethod { paretoTournament, randomObjTournament, nsga2Tournament };
-template <typename DNA> class GA {
- protected:
-    /*********************************************************************************
-     *                            MAIN GA SETTINGS
-     ********************************************************************************/
-    bool novelty = false;              // enable novelty
-    unsigned int verbosity = 2;        // 0 = silent; 1 = ions stats;
-                                       // 2 = individuals stats; 3 = everything
-    size_t popSize = 500;              // nb of individuals in the population
-    size_t nbElites = 1;               // nb of elites to keep accross generations
-    size_t nbSavedElites = 1;          // nb of elites to save
-    size_t tournamentSize = 3;         // nb of competitors in tournament
-    double minNoveltyForArchive = 1;   // min novelty for being added to the general archive
-    size_t KNN = 15;                   // size of the neighbourhood for novelty
-    bool savePopEnabled = true;        // save the whole population
-    bool saveArchiveEnabled = true;    // save the novelty archive
-    unsigned int savePopInterval = 1;  // interval between 2 whole population saves
-    unsigned int saveGenInterval = 1;  // interval between 2 elites/pareto saves
-    string folder = "../evos/";        // where to save the results
-    string evaluatorName;              // name of the given evaluator func
-    double crossoverProba = 0.2;       // crossover probability
-    double mutationProba = 0.5;        // mutation probablility
-    bool evaluateAllIndividuals = false;  // force evaluation of every individual
-    bool doSaveParetoFront = false;       // save the pareto front
-    bool doSaveGenStats = true;           // save generations stats to csv file
-    bool doSaveIndStats = false;          // save individuals stats to csv file
-    SelectionMethod selecMethod = SelectionMethod::paretoTournament;
 
-    /********************************************************************************
-     *                                 SETTERS
-     ********************************************************************************/
- public:
-    using DNA_t = DNA;
-    void enableNovelty() { novelty = true; }
-    void disableNovelty() { novelty = false; }
-    void enablePopulationSave() { savePopEnabled = true; }
-    void disablePopulationSave() { savePopEnabled = false; }
-    void enableArchiveSave() { saveArchiveEnabled = true; }
-    void disableArchiveSave() { saveArchiveEnabled = false; }
-    void setVerbosity(unsigned int lvl) { verbosity = lvl <= 3 ? (lvl >= 0 ? lvl : 0) : 3; }
-    void setPopSize(size_t s) { popSize = s; }
-    void setNbElites(size_t n) { nbElites = n; }
-    void setNbSavedElites(size_t n) { nbSavedElites = n; }
-    void setTournamentSize(size_t n) { tournamentSize = n; }
-    void setKNN(size_t n) { KNN = n; }
-    void setPopSaveInterval(unsigned int n) { savePopInterval = n; }
-    void setGenSaveInterval(unsigned int n) { saveGenInterval = n; }
-    void setSaveFolder(string s) { folder = s; }
-    void setCrossoverProba(double p) {
-        crossoverProba = p <= 1.0 ? (p >= 0.0 ? p : 0.0) : 1.0;
-    }
-    void setMutationProba(double p) {
-        mutationProba = p <= 1.0 ? (p >= 0.0 ? p : 0.0) : 1.0;
-    }
-    void setEvaluator(std::function<void(Individual<DNA> &)> e,
-                      std::string ename = "anonymousEvaluator") {
-        evaluator = e;
-        evaluatorName = ename;
+    // Streaming versions (see JSON POPULATION STREAMS), header holds the other fields
+    static void popToJSON(std::ostream &out, const vector<Individual<DNA>> &p,
+                          const json &header = json::object()) {
+        PopulationJSONWriter w(out, header);
+        for (auto &i : p) w.write(i.toJSON());
+        w.close();
     }
-    void setNewGenerationFunction(std::function<void(void)> f) {
-        newGenerationFunction = f;
+    static vector<Individual<DNA>> loadPopFromJSON(std::istream &in, json *header = nullptr) {
+        vector<Individual<DNA>> res;
+        json h = readPopulationJSON(in, [&](const json &o) { res.emplace_back(o); });
+        if (header) *header = std::move(h);
+        return res;
     }
-    void setMinNoveltyForArchive(double m) { minNoveltyForArchive = m; }
-    void setIsBetterMethod(std::function<bool(double, double)> f) { isBetter = f; }
-    void setSelectionMethod(const SelectionMethod &sm) {
-        selecMethod = sm;
-        switch (sm) {
-            case SelectionMethod::paretoTournament:
-                selection = [this]() { return paretoTournament(); };
-                break;
+};
 
-            case SelectionMethod::nsga2Tournament:
-                // NOTE(charly): Should not be needed
-                break;
+/*****************************************************************************
+ *                         POPULATION FILES
+ * **************************************************************************/
+// Versioned binary container for whole populations (native byte order, like the other
+// binary codecs). Every section starts on an 8 bytes boundary:
+// [header][names][records][dna & infos blobs][index]
+// - header: magic, version, byte order mark, then nb of individuals, generation (-1 if
+//   none), nb of objectives, footprint shape (nb snapshots, snapshot size), record size and
+//   the offsets of the 4 sections
+// - names: evaluator name, DNA store (since version 2), then the name of each objective
+//   (size prefixed strings)
+// - records: one fixed size record per individual: flags, evalTime, one fitness per
+//   objective (in names order) and the flattened footprint
+// - index: for each individual, offset of its blob, size of its dna and size of its infos
+// The index is written last, so that individuals are serialized one at a time. Individuals
+// that have fitnesses must all have the same objectives, and footprints the same shape.
+// When the DNA store is set (path of a DNAStore's pack, relative to the population file's
+// folder), dna blobs are (offset, size) references into this pack instead of the DNAs.
+
+// DNA kept as its serialized string, for tools that don't know the actual DNA type
+struct RawDNA {
+    string str;
+    RawDNA() {}
+    explicit RawDNA(const string &s) : str(s) {}
+    string serialize() const { return str; }
+};
 
-            case SelectionMethod::randomObjTournament:
-            default:
-                selection = [this]() { return randomObjTournament(); };
-                break;
+// Read only memory mapping of a whole file (plain read where mmap isn't available)
+class MappedFile {
+ public:
+    MappedFile() {}
+    explicit MappedFile(const string &path) { open(path); }
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    void open(const string &path) {
+        close();
+#if defined(_WIN32)
+        std::ifstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("Cannot open " + path);
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        ptr = buffer.data();
+        len = buffer.size();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        len = static_cast<size_t>(st.st_size);
+        if (len > 0) {
+            void *p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map " + path);
+            }
+            ptr = static_cast<const char *>(p);
         }
+        ::close(fd);
+#endif
     }
 
-    void setEvaluateAllIndividuals(bool m) { evaluateAllIndividuals = m; }
-    void setSaveParetoFront(bool m) { doSaveParetoFront = m; }
-    void setSaveGenStats(bool m) { doSaveGenStats = m; }
-    void setSaveIndStats(bool m) { doSaveIndStats = m; }
-    vector<Individual<DNA>> population;
-    vector<Individual<DNA>> lastGen;
+    void close() {
+#if defined(_WIN32)
+        buffer.clear();
+#else
+        if (ptr) munmap(const_cast<char *>(ptr), len);
+#endif
+        ptr = nullptr;
+        len = 0;
+    }
 
-    ////////////////////////////////////////////////////////////////////////////////////
+    const char *data() const { return ptr; }
+    size_t size() const { return len; }
 
- protected:
-    vector<Individual<DNA>>
-        archive;  // when novelty is enabled, we store the novel individuals there
-    size_t currentGeneration = 0;
-    bool customInit = false;
-    // openmp/mpi stuff
-    int procId = 0;
-    int nbProcs = 1;
-    int argc = 1;
-    char **argv = nullptr;
+ private:
+    const char *ptr = nullptr;
+    size_t len = 0;
+#if defined(_WIN32)
+    vector<char> buffer;
+#endif
+};
 
-    std::vector<std::map<std::string, std::map<std::string, double>>> genStats;
+// Content addressed, append only store of serialized DNAs: each distinct DNA is written
+// once, and population files only keep a reference to it (see PopulationFile::write).
+// The pack file is [magic]([size][dna])*, references are (offset, size) of a dna's bytes.
+// DNAs are looked up by a 64 bits hash of their bytes (Hash), and the stored bytes of a
+// candidate are compared with the DNA's before it's reused. Only used by one thread at a
+// time.
+struct DNAHash {
+    uint64_t operator()(const char *data, size_t size) const {
+        uint64_t h = 0xcbf29ce484222325ULL;  // FNV-1a, then mixed
+        for (size_t i = 0; i < size; ++i)
+            h = (h ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+        return mixSeed(h ^ size);
+    }
+};
 
-    std::random_device rd;
-    std::default_random_engine globalRand = std::default_random_engine(rd());
+template <typename Hash = DNAHash> class BasicDNAStore {
+ public:
+    using Ref = std::pair<uint64_t, uint64_t>;  // offset & size in the pack file
+    static constexpr size_t magicSize = 8;
+    static const char *magic() { return "GAGADNA"; }  // with its trailing '\0'
+
+    ~BasicDNAStore() { close(); }
+
+    // Opens (or creates) a pack file. The DNAs it already holds are indexed, and a
+    // truncated last entry (interrupted write) is dropped.
+    void open(const string &p) {
+        close();
+        packPath = p;
+        end = magicSize;
+        if (fs::exists(p) && fs::file_size(p) > 0) {
+            MappedFile existing(p);
+            const char *begin = existing.data(), *last = begin + existing.size();
+            if (existing.size() < magicSize || !std::equal(begin, begin + magicSize, magic()))
+                throw std::runtime_error(p + " is not a DNA store");
+            const char *cur = begin + magicSize;
+            while (static_cast<size_t>(last - cur) >= sizeof(uint64_t)) {
+                uint64_t size;
+                std::memcpy(&size, cur, sizeof(size));
+                if (size > static_cast<uint64_t>(last - cur) - sizeof(uint64_t)) break;
+                cur += sizeof(uint64_t);
+                index.emplace(hash(cur, size), Ref(static_cast<uint64_t>(cur - begin), size));
+                cur += size;
+            }
+            end = static_cast<uint64_t>(cur - begin);
+            existing.close();
+            fs::resize_file(p, end);
+            file.open(p, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(end));
+        } else {
+            file.open(p, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+            file.write(magic(), magicSize);
+        }
+        if (!file) throw std::runtime_error("Cannot open " + p);
+    }
+    void close() {
+        if (file.is_open()) file.close();
+        index.clear();
+    }
+    bool isOpen() const { return file.is_open(); }
+    const string &path() const { return packPath; }
+    size_t size() const { return index.size(); }  // nb of distinct DNAs
+    void flush() { file.flush(); }
+
+    // Reference to the stored copy of dna, which is only written if it's new
+    Ref put(const string &dna) {
+        const uint64_t h = hash(dna.data(), dna.size());
+        auto range = index.equal_range(h);
+        for (auto it = range.first; it != range.second; ++it)
+            if (it->second.second == dna.size() && storedEquals(it->second, dna))
+                return it->second;
+        Ref ref(end + sizeof(uint64_t), dna.size());
+        string entry;
+        binaryPut(entry, ref.second);
+        file.seekp(static_cast<std::streamoff>(end));
+        file.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+        file.write(dna.data(), static_cast<std::streamsize>(dna.size()));
+        end = ref.first + ref.second;
+        index.emplace(h, ref);
+        return ref;
+    }
 
-    std::function<void(Individual<DNA> &)> evaluator;
-    std::function<Individual<DNA> *()> selection;
-    std::function<void(void)> newGenerationFunction = []() {};
-    std::function<bool(double, double)> isBetter = [](double a, double b) { return a > b; };
+ protected:
+    std::fstream file;
+    string packPath;
+    uint64_t end = 0;  // size of the pack file
+    std::unordered_multimap<uint64_t, Ref> index;
+    string readBack;  // stored bytes of a candidate (see storedEquals)
+    Hash hash;
+
+    // true if the bytes stored at ref are dna's. Leaves the put position undefined.
+    bool storedEquals(const Ref &ref, const string &dna) {
+        readBack.resize(static_cast<size_t>(ref.second));
+        file.flush();
+        file.seekg(static_cast<std::streamoff>(ref.first));
+        file.read(&readBack[0], static_cast<std::streamsize>(readBack.size()));
+        if (!file) throw std::runtime_error("Cannot read " + packPath);
+        return readBack == dna;
+    }
+};
+using DNAStore = BasicDNAStore<>;
+
+// Writes populations with write() and gives random access to the individuals of a
+// mapped file: nothing but the header and the names is read until an individual is asked.
+class PopulationFile {
+ public:
+    static constexpr uint32_t version = 2;
+    static constexpr uint32_t byteOrderMark = 0x01020304;
+    static constexpr size_t magicSize = 8;
+    static const char *magic() { return "GAGAPOP"; }  // with its trailing '\0'
+    static constexpr uint64_t headerSize = 8 + 4 + 4 + 10 * 8;
+    static constexpr uint64_t indexEntrySize = 3 * 8;
+    // record flags
+    static constexpr uint64_t evaluatedFlag = 1, alreadyEvaluatedFlag = 2, fitnessesFlag = 4,
+                              footprintFlag = 8;
+
+    PopulationFile() {}
+    explicit PopulationFile(const string &path) { open(path); }
+    // population file stored in [offset, offset + size) of a mapped file (see RunLog)
+    PopulationFile(std::shared_ptr<const MappedFile> f, size_t offset, size_t size) {
+        open(std::move(f), offset, size);
+    }
+
+    // true if path starts like a population file (used to tell them from json files)
+    static bool isPopulationFile(const string &path) {
+        std::ifstream file(path, std::ios::binary);
+        char m[magicSize] = {};
+        file.read(m, magicSize);
+        return file && std::equal(m, m + magicSize, magic());
+    }
+
+    // With a store, new DNAs are added to it and only referenced: storeRef is the path of
+    // its pack relative to the folder of path.
+    template <typename DNA>
+    static void write(const string &path, const vector<Individual<DNA>> &pop,
+                      const string &evaluator = "", int64_t generation = -1,
+                      DNAStore *store = nullptr, const string &storeRef = "") {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) throw std::runtime_error("Cannot open " + path);
+        write(file, pop, evaluator, generation, store, storeRef);
+        if (!file) throw std::runtime_error("Cannot write " + path);
+    }
+    // Same, at the current position of a seekable stream
+    template <typename DNA>
+    static void write(std::ostream &file, const vector<Individual<DNA>> &pop,
+                      const string &evaluator = "", int64_t generation = -1,
+                      DNAStore *store = nullptr, const string &storeRef = "") {
+        assert(!store || !storeRef.empty());
+        const auto start = file.tellp();
+        // objective names and footprint shape are given by the first individuals having them
+        vector<string> names;
+        uint64_t nbSnapshots = 0, snapshotSize = 0;
+        bool foundFitnesses = false, foundFootprint = false;
+        for (const auto &ind : pop) {
+            if (!foundFitnesses && !ind.fitnesses.empty()) {
+                for (const auto &f : ind.fitnesses) names.push_back(f.first);
+                foundFitnesses = true;
+            }
+            if (!foundFootprint && !ind.footprint.empty()) {
+                nbSnapshots = ind.footprint.size();
+                snapshotSize = ind.footprint[0].size();
+                foundFootprint = true;
+            }
+        }
+        const uint64_t recordSize = 16 + 8 * (names.size() + nbSnapshots * snapshotSize);
+
+        string buf;
+        buf.resize(headerSize);  // written last
+        const uint64_t namesOffset = headerSize;
+        binaryPut(buf, evaluator);
+        binaryPut(buf, store ? storeRef : string());
+        for (const auto &n : names) binaryPut(buf, n);
+        pad(buf);
+        const uint64_t recordsOffset = buf.size();
+        file.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+
+        for (const auto &ind : pop) {
+            buf.clear();
+            uint64_t flags = (ind.evaluated ? evaluatedFlag : 0) |
+                             (ind.wasAlreadyEvaluated ? alreadyEvaluatedFlag : 0);
+            if (!ind.fitnesses.empty()) {
+                flags |= fitnessesFlag;
+                if (ind.fitnesses.size() != names.size())
+                    throw std::invalid_argument(
+                        "PopulationFile: individuals have different objectives");
+            }
+            if (!ind.footprint.empty()) {
+                flags |= footprintFlag;
+                if (ind.footprint.size() != nbSnapshots)
+                    throw std::invalid_argument("PopulationFile: footprints have different shapes");
+            }
+            binaryPut(buf, flags);
+            binaryPut(buf, ind.evalTime);
+            if (ind.fitnesses.empty()) {
+                for (size_t o = 0; o < names.size(); ++o) binaryPut(buf, 0.0);
+            } else {
+                size_t o = 0;
+                for (const auto &f : ind.fitnesses) {  // maps are sorted, like names
+                    if (f.first != names[o++])
+                        throw std::invalid_argument(
+                        "PopulationFile: individuals have different objectives");
+                    binaryPut(buf, f.second);
+                }
+            }
+            if (ind.footprint.empty()) {
+                for (uint64_t v = 0; v < nbSnapshots * snapshotSize; ++v) binaryPut(buf, 0.0);
+            } else {
+                for (const auto &snapshot : ind.footprint) {
+                    if (snapshot.size() != snapshotSize)
+                        throw std::invalid_argument(
+                            "PopulationFile: footprints have different shapes");
+                    for (auto v : snapshot) binaryPut(buf, v);
+                }
+            }
+            file.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        }
+
+        const uint64_t blobsOffset = recordsOffset + pop.size() * recordSize;
+        string index;
+        index.reserve(pop.size() * indexEntrySize);
+        uint64_t offset = blobsOffset;
+        for (const auto &ind : pop) {
+            string dna = ind.dna.serialize();
+            if (store) {
+                auto ref = store->put(dna);
+                dna.clear();
+                binaryPut(dna, ref.first);
+                binaryPut(dna, ref.second);
+            }
+            binaryPut(index, offset);
+            binaryPut(index, static_cast<uint64_t>(dna.size()));
+            binaryPut(index, static_cast<uint64_t>(ind.infos.size()));
+            file.write(dna.data(), static_cast<std::streamsize>(dna.size()));
+            file.write(ind.infos.data(), static_cast<std::streamsize>(ind.infos.size()));
+            offset += dna.size() + ind.infos.size();
+        }
+        if (store) store->flush();
+        buf.assign((8 - offset % 8) % 8, '\0');
+        file.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        const uint64_t indexOffset = offset + buf.size();
+        file.write(index.data(), static_cast<std::streamsize>(index.size()));
+
+        buf.assign(magic(), magicSize);
+        binaryPut(buf, uint32_t(version));
+        binaryPut(buf, uint32_t(byteOrderMark));
+        for (uint64_t v : {static_cast<uint64_t>(pop.size()), static_cast<uint64_t>(generation),
+                           static_cast<uint64_t>(names.size()), nbSnapshots, snapshotSize,
+                           recordSize, namesOffset, recordsOffset, blobsOffset, indexOffset})
+            binaryPut(buf, v);
+        file.seekp(start);
+        file.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        file.seekp(0, std::ios::end);
+    }
+
+    void open(const string &path) {
+        auto f = std::make_shared<MappedFile>(path);
+        const size_t size = f->size();
+        parse(std::move(f), 0, size, path);
+    }
+    void open(std::shared_ptr<const MappedFile> f, size_t offset, size_t size) {
+        if (offset > f->size() || size > f->size() - offset)
+            throw std::runtime_error("Population file out of the mapped file");
+        parse(std::move(f), offset, size, "");
+    }
+
+    size_t size() const { return nbIndividuals; }
+    bool hasGeneration() const { return gen >= 0; }
+    size_t generation() const { return static_cast<size_t>(gen); }
+    const string &evaluator() const { return evaluatorName; }
+    const vector<string> &objectives() const { return names; }
+
+    bool isEvaluated(size_t i) const { return flags(i) & evaluatedFlag; }
+    double fitness(size_t i, size_t o) const {
+        assert(o < names.size());
+        return get<double>(record(i) + 16 + 8 * o);
+    }
+    // serialized dna, as given to DNA's constructor
+    string dna(size_t i) const {
+        auto b = blob(i);
+        return string(b.dna, b.dnaSize);
+    }
+
+    template <typename DNA> Individual<DNA> individual(size_t i) const {
+        auto b = blob(i);
+        Individual<DNA> ind{DNA(string(b.dna, b.dnaSize))};
+        ind.infos.assign(b.infos, b.infosSize);
+        const char *r = record(i);
+        const auto f = get<uint64_t>(r);
+        ind.evaluated = f & evaluatedFlag;
+        ind.wasAlreadyEvaluated = f & alreadyEvaluatedFlag;
+        ind.evalTime = get<double>(r + 8);
+        if (f & fitnessesFlag)
+            for (size_t o = 0; o < names.size(); ++o) ind.fitnesses[names[o]] = fitness(i, o);
+        if (f & footprintFlag) {
+            const char *v = r + 16 + 8 * names.size();
+            ind.footprint.assign(nbSnapshots, vector<double>(snapshotSize));
+            for (auto &snapshot : ind.footprint)
+                for (auto &x : snapshot) {
+                    x = get<double>(v);
+                    v += 8;
+                }
+        }
+        return ind;
+    }
+
+    template <typename DNA> vector<Individual<DNA>> individuals() const {
+        vector<Individual<DNA>> res;
+        res.reserve(size());
+        for (size_t i = 0; i < size(); ++i) res.push_back(individual<DNA>(i));
+        return res;
+    }
+
+    // same document as a json population save
+    json toJSON() const {
+        json o = Individual<RawDNA>::popToJSON(individuals<RawDNA>());
+        o["evaluator"] = evaluatorName;
+        if (hasGeneration()) o["generation"] = generation();
+        return o;
+    }
+    // streamed, one individual at a time (header: additional fields)
+    void writeJSON(std::ostream &out, json header = json::object()) const {
+        header["evaluator"] = evaluatorName;
+        if (hasGeneration()) header["generation"] = generation();
+        PopulationJSONWriter w(out, header);
+        for (size_t i = 0; i < size(); ++i) w.write(individual<RawDNA>(i).toJSON());
+        w.close();
+    }
+
+ private:
+    std::shared_ptr<const MappedFile> file;
+    const char *base = nullptr;  // the population file, in file
+    size_t len = 0;
+    std::shared_ptr<const MappedFile> storePack;  // pack of the DNA store, if any
+    uint64_t nbIndividuals = 0;
+    int64_t gen = -1;
+    uint64_t nbSnapshots = 0, snapshotSize = 0, recordSize = 0;
+    uint64_t recordsOffset = 0, indexOffset = 0;
+    string evaluatorName;
+    vector<string> names;
+
+    static void pad(string &buf) { buf.resize((buf.size() + 7) / 8 * 8, '\0'); }
+    // reads the header and the names of the population file in [offset, offset + size) of f
+    void parse(std::shared_ptr<const MappedFile> f, size_t offset, size_t size,
+               const string &path) {
+        file = std::move(f);
+        base = file->data() + offset;
+        len = size;
+        const string name = path.empty() ? "Population file" : path;
+        const char *end = base + len;
+        const char *cur = base;
+        if (len < headerSize || !std::equal(base, base + magicSize, magic()))
+            throw std::runtime_error(name + " is not a population file");
+        cur += magicSize;
+        const auto fileVersion = binaryGet<uint32_t>(cur, end);
+        if (fileVersion > version)
+            throw std::runtime_error(name + " was written by a newer version of gaga");
+        if (binaryGet<uint32_t>(cur, end) != byteOrderMark)
+            throw std::runtime_error(name + " was written with another byte order");
+        nbIndividuals = binaryGet<uint64_t>(cur, end);
+        gen = static_cast<int64_t>(binaryGet<uint64_t>(cur, end));
+        auto nbObjectives = binaryGet<uint64_t>(cur, end);
+        nbSnapshots = binaryGet<uint64_t>(cur, end);
+        snapshotSize = binaryGet<uint64_t>(cur, end);
+        recordSize = binaryGet<uint64_t>(cur, end);
+        auto namesOffset = binaryGet<uint64_t>(cur, end);
+        recordsOffset = binaryGet<uint64_t>(cur, end);
+        binaryGet<uint64_t>(cur, end);  // blobs offset, the index points inside
+        indexOffset = binaryGet<uint64_t>(cur, end);
+        if (recordSize != 16 + 8 * (nbObjectives + nbSnapshots * snapshotSize) ||
+            recordsOffset + nbIndividuals * recordSize > len ||
+            indexOffset + nbIndividuals * indexEntrySize > len || namesOffset > len)
+            throw std::runtime_error(name + " is corrupted");
+        cur = base + namesOffset;
+        evaluatorName = binaryGetString(cur, end);
+        const string storeRef = fileVersion >= 2 ? binaryGetString(cur, end) : "";
+        names.clear();
+        for (uint64_t o = 0; o < nbObjectives; ++o) names.push_back(binaryGetString(cur, end));
+        if (storeRef.empty()) {
+            storePack.reset();
+        } else {
+            if (path.empty()) throw std::runtime_error("No folder to find the DNA store in");
+            storePack = std::make_shared<MappedFile>(
+                (fs::path(path).parent_path() / storeRef).string());
+        }
+    }
+    template <typename T> static T get(const char *p) {
+        T v;
+        std::memcpy(&v, p, sizeof(T));
+        return v;
+    }
+    const char *record(size_t i) const {
+        if (i >= nbIndividuals) throw std::out_of_range("PopulationFile: no such individual");
+        return base + recordsOffset + i * recordSize;
+    }
+    uint64_t flags(size_t i) const { return get<uint64_t>(record(i)); }
+    struct Blob {
+        const char *dna;
+        uint64_t dnaSize;
+        const char *infos;
+        uint64_t infosSize;
+    };
+    // dna (from the store, if any) and infos of an individual
+    Blob blob(size_t i) const {
+        if (i >= nbIndividuals) throw std::out_of_range("PopulationFile: no such individual");
+        const char *e = base + indexOffset + i * indexEntrySize;
+        auto offset = get<uint64_t>(e), dnaSize = get<uint64_t>(e + 8),
+             infosSize = get<uint64_t>(e + 16);
+        if (offset > len || dnaSize + infosSize > len - offset)
+            throw std::runtime_error("PopulationFile: corrupted index");
+        Blob b{base + offset, dnaSize, base + offset + dnaSize, infosSize};
+        if (storePack) {
+            if (dnaSize != 16) throw std::runtime_error("PopulationFile: corrupted index");
+            auto ref = get<uint64_t>(b.dna);
+            b.dnaSize = get<uint64_t>(b.dna + 8);
+            if (ref > storePack->size() || b.dnaSize > storePack->size() - ref)
+                throw std::runtime_error("PopulationFile: reference out of the DNA store");
+            b.dna = storePack->data() + ref;
+        }
+        return b;
+    }
+};
+
+/*****************************************************************************
+ *                               RUN LOG
+ * **************************************************************************/
+// Append only log of a run's saves, instead of a folder per generation: each record is a
+// population file (see PopulationFile) of some kind (population, archive, elites of an
+// objective, Pareto front) for a generation. Records are appended to segments (runlog.0,
+// runlog.1, ...) of at most segmentSize bytes (a record larger than that gets its own
+// segment), and runlog.idx indexes them: a header (magic, version, byte order mark), then
+// for each record its generation, kind, segment, offset, size and objective ("" if none).
+// A record is indexed once its data is flushed, so an interrupted run only loses its
+// last, unindexed, record.
+enum class RunLogKind : uint32_t { population, archive, elites, paretoFront };
+
+inline const char *runLogKindName(RunLogKind k) {
+    switch (k) {
+        case RunLogKind::population:
+            return "population";
+        case RunLogKind::archive:
+            return "archive";
+        case RunLogKind::elites:
+            return "elites";
+        case RunLogKind::paretoFront:
+            return "paretoFront";
+    }
+    return "???";
+}
+
+struct RunLogEntry {
+    uint64_t generation = 0;
+    RunLogKind kind = RunLogKind::population;
+    uint32_t segment = 0;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    string objective;
+};
+
+struct RunLogFormat {
+    static constexpr uint32_t version = 1;
+    static constexpr size_t magicSize = 8;
+    static const char *magic() { return "GAGALOG"; }  // with its trailing '\0'
+    static string indexPath(const string &dir) { return dir + "/runlog.idx"; }
+    static string segmentPath(const string &dir, uint32_t s) {
+        return dir + "/runlog." + std::to_string(s);
+    }
+    // Reads the entries of an index, and returns the size of its valid part. The entries
+    // from the first one of generation endGeneration or later are left out.
+    static size_t readIndex(const string &dir, vector<RunLogEntry> &entries,
+                            uint64_t endGeneration = std::numeric_limits<uint64_t>::max()) {
+        entries.clear();
+        MappedFile idx(indexPath(dir));
+        const char *begin = idx.data(), *end = begin + idx.size(), *cur = begin;
+        if (idx.size() < magicSize + 8 || !std::equal(begin, begin + magicSize, magic()))
+            throw std::runtime_error(indexPath(dir) + " is not a run log index");
+        cur += magicSize;
+        if (binaryGet<uint32_t>(cur, end) > version)
+            throw std::runtime_error(indexPath(dir) + " was written by a newer version of gaga");
+        if (binaryGet<uint32_t>(cur, end) != PopulationFile::byteOrderMark)
+            throw std::runtime_error(indexPath(dir) + " was written with another byte order");
+        size_t valid = static_cast<size_t>(cur - begin);
+        try {
+            while (cur < end) {
+                RunLogEntry e;
+                e.generation = binaryGet<uint64_t>(cur, end);
+                e.kind = binaryGet<RunLogKind>(cur, end);
+                e.segment = binaryGet<uint32_t>(cur, end);
+                e.offset = binaryGet<uint64_t>(cur, end);
+                e.size = binaryGet<uint64_t>(cur, end);
+                e.objective = binaryGetString(cur, end);
+                if (e.generation >= endGeneration) break;
+                entries.push_back(std::move(e));
+                valid = static_cast<size_t>(cur - begin);
+            }
+        } catch (const std::runtime_error &) {  // truncated last entry
+        }
+        return valid;
+    }
+};
+
+// Writes a run log. Only used by one thread at a time.
+class RunLogWriter {
+ public:
+    ~RunLogWriter() { close(); }
+
+    // Starts a run log in dir, or appends to the one already there. When appending, the
+    // records of generations from fromGeneration on (e.g. written after the checkpoint that
+    // is being resumed) are dropped, as well as what was written after the last record.
+    void open(const string &d, bool append = false,
+              uint64_t fromGeneration = std::numeric_limits<uint64_t>::max()) {
+        close();
+        dir = d;
+        segment = 0;
+        segmentEnd = 0;
+        const bool resume = append && fs::exists(RunLogFormat::indexPath(dir));
+        if (resume) {
+            vector<RunLogEntry> entries;
+            fs::resize_file(RunLogFormat::indexPath(dir),
+                            RunLogFormat::readIndex(dir, entries, fromGeneration));
+            if (!entries.empty()) {
+                segment = entries.back().segment;
+                segmentEnd = entries.back().offset + entries.back().size;
+            }
+            if (fs::exists(RunLogFormat::segmentPath(dir, segment)))
+                fs::resize_file(RunLogFormat::segmentPath(dir, segment), segmentEnd);
+            for (uint32_t s = segment + 1; fs::exists(RunLogFormat::segmentPath(dir, s)); ++s)
+                fs::remove(RunLogFormat::segmentPath(dir, s));
+            index.open(RunLogFormat::indexPath(dir), std::ios::binary | std::ios::app);
+        } else {
+            index.open(RunLogFormat::indexPath(dir), std::ios::binary | std::ios::trunc);
+            string header(RunLogFormat::magic(), RunLogFormat::magicSize);
+            binaryPut(header, uint32_t(RunLogFormat::version));
+            binaryPut(header, uint32_t(PopulationFile::byteOrderMark));
+            index.write(header.data(), static_cast<std::streamsize>(header.size()));
+            index.flush();
+        }
+        openSegment(!resume);
+        if (!index) throw std::runtime_error("Cannot open " + RunLogFormat::indexPath(dir));
+    }
+    void close() {
+        if (data.is_open()) data.close();
+        if (index.is_open()) index.close();
+    }
+    bool isOpen() const { return index.is_open(); }
+    void setSegmentSize(uint64_t s) { segmentSize = s > 0 ? s : 1; }
+    uint64_t getSegmentSize() const { return segmentSize; }
+
+    void append(size_t generation, RunLogKind kind, const string &objective,
+                const string &record) {
+        if (segmentEnd > 0 && segmentEnd + record.size() > segmentSize) {
+            ++segment;
+            segmentEnd = 0;
+            openSegment(true);
+        }
+        data.write(record.data(), static_cast<std::streamsize>(record.size()));
+        data.flush();
+        string entry;
+        binaryPut(entry, static_cast<uint64_t>(generation));
+        binaryPut(entry, kind);
+        binaryPut(entry, segment);
+        binaryPut(entry, segmentEnd);
+        binaryPut(entry, static_cast<uint64_t>(record.size()));
+        binaryPut(entry, objective);
+        index.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+        index.flush();
+        segmentEnd += record.size();
+        if (!data || !index) cerr << "Cannot write the run log in " << dir << endl;
+    }
+
+ protected:
+    string dir;
+    std::ofstream index, data;
+    uint32_t segment = 0;
+    uint64_t segmentEnd = 0;
+    uint64_t segmentSize = uint64_t(1) << 30;
+
+    void openSegment(bool truncate) {
+        if (data.is_open()) data.close();
+        data.open(RunLogFormat::segmentPath(dir, segment),
+                  std::ios::binary | (truncate ? std::ios::trunc : std::ios::app));
+    }
+};
+
+// Reads a run log, possibly while it's being written (reload() sees the new records)
+class RunLog {
+ public:
+    RunLog() {}
+    explicit RunLog(const string &d) { open(d); }
+
+    void open(const string &d) {
+        dir = d;
+        segments.clear();
+        reload();
+    }
+    void reload() { RunLogFormat::readIndex(dir, entries); }
+
+    const vector<RunLogEntry> &getEntries() const { return entries; }
+
+    // entries of a generation and kind, for any objective if objective is "*"
+    vector<const RunLogEntry *> find(size_t generation, RunLogKind kind,
+                                     const string &objective = "*") const {
+        vector<const RunLogEntry *> res;
+        for (const auto &e : entries)
+            if (e.generation == generation && e.kind == kind &&
+                (objective == "*" || e.objective == objective))
+                res.push_back(&e);
+        return res;
+    }
+
+    PopulationFile read(const RunLogEntry &e) {
+        if (segments.size() <= e.segment) segments.resize(e.segment + 1);
+        auto &seg = segments[e.segment];
+        if (!seg || seg->size() < e.offset + e.size)  // the segment has grown since mapped
+            seg = std::make_shared<MappedFile>(RunLogFormat::segmentPath(dir, e.segment));
+        return PopulationFile(seg, e.offset, e.size);
+    }
+
+ protected:
+    string dir;
+    vector<RunLogEntry> entries;
+    vector<std::shared_ptr<const MappedFile>> segments;
+};
+
+/*****************************************************************************
+ *                         OBJECTIVE MATRIX
+ * **************************************************************************/
+// Dense copy of the fitnesses of a population, so that sorting and selection work on
+// contiguous doubles instead of std::map lookups. Objectives are those of the first
+// individual, in std::map (alphabetical) order. Values are stored column by column:
+// column o is values[o * nbRows, (o+1) * nbRows).
+struct ObjectiveMatrix {
+    vector<string> names;
+    vector<double> values;
+    size_t nbRows = 0;
+
+    ObjectiveMatrix() {}
+    template <typename DNA>
+    explicit ObjectiveMatrix(const vector<Individual<DNA>> &pop) : nbRows(pop.size()) {
+        fill([&](size_t i) -> const Individual<DNA> & { return pop[i]; });
+    }
+    template <typename DNA>
+    explicit ObjectiveMatrix(const vector<Individual<DNA> *> &pop) : nbRows(pop.size()) {
+        fill([&](size_t i) -> const Individual<DNA> & { return *pop[i]; });
+    }
+    template <typename DNA>
+    explicit ObjectiveMatrix(const vector<const Individual<DNA> *> &pop) : nbRows(pop.size()) {
+        fill([&](size_t i) -> const Individual<DNA> & { return *pop[i]; });
+    }
+
+    size_t nbObjectives() const { return names.size(); }
+    double operator()(size_t i, size_t o) const { return values[o * nbRows + i]; }
+    const double *column(size_t o) const { return values.data() + o * nbRows; }
+
+ protected:
+    template <typename Row> void fill(Row row) {
+        if (nbRows == 0) return;
+        for (const auto &f : row(0).fitnesses) names.push_back(f.first);
+        values.resize(nbRows * names.size());
+        for (size_t o = 0; o < names.size(); ++o) {
+            for (size_t i = 0; i < nbRows; ++i) {
+                // a missing objective counts as 0, like a default inserted map entry
+                const auto &fit = row(i).fitnesses;
+                auto f = fit.find(names[o]);
+                values[o * nbRows + i] = f == fit.end() ? 0.0 : f->second;
+            }
+        }
+    }
+};
+
+/*****************************************************************************
+ *                           PARETO FRONT
+ * **************************************************************************/
+// First front of the rows of an objective matrix. Row a dominates row b if it is better on
+// every objective; the front is made of the rows that no other row dominates.
+// The rows are sorted on the first objective (best first), so that a row can only be
+// dominated by rows sorted before it. Then:
+// - with 1 or 2 objectives, one sweep keeps the best value of the second objective among
+//   the rows that are strictly better on the first one: O(N log N)
+// - with 3 objectives or more, Kung's divide and conquer: the front of the second half
+//   is filtered by the front of the first half
+// The sorted order is scratch data owned by the extractor, which keeps its capacity.
+class ParetoFrontExtractor {
+ public:
+    using Comparator = std::function<bool(double, double)>;
+
+    static bool dominates(const ObjectiveMatrix &obj, size_t a, size_t b,
+                          const Comparator &isBetter) {
+        for (size_t o = 0; o < obj.nbObjectives(); ++o)
+            if (!isBetter(obj(a, o), obj(b, o))) return false;
+        return obj.nbObjectives() > 0;
+    }
+
+    // onFront[i] is true if row i is on the first front
+    void extract(const ObjectiveMatrix &obj, const Comparator &isBetter, vector<bool> &onFront) {
+        const size_t n = obj.nbRows;
+        onFront.assign(n, obj.nbObjectives() == 0);
+        if (n == 0 || obj.nbObjectives() == 0) return;
+        order.resize(n);
+        for (size_t i = 0; i < n; ++i) order[i] = static_cast<uint32_t>(i);
+        const double *c0 = obj.column(0);
+        std::sort(order.begin(), order.end(),
+                  [&](uint32_t a, uint32_t b) { return isBetter(c0[a], c0[b]); });
+        if (obj.nbObjectives() <= 2) {
+            sweep(obj, isBetter, onFront);
+        } else {
+            size_t nbFront = kung(obj, isBetter, order.data(), n);
+            for (size_t k = 0; k < nbFront; ++k) onFront[order[k]] = true;
+        }
+    }
+
+ protected:
+    vector<uint32_t> order;
+
+    void sweep(const ObjectiveMatrix &obj, const Comparator &isBetter, vector<bool> &onFront) {
+        const double *c0 = obj.column(0);
+        const double *c1 = obj.nbObjectives() > 1 ? obj.column(1) : nullptr;
+        bool hasBest = false;  // a row is strictly better on the first objective
+        double best1 = 0.0;    // and this is the best second objective of these rows
+        size_t g = 0;
+        while (g < order.size()) {
+            // rows tied on the first objective can't dominate each other
+            size_t end = g + 1;
+            while (end < order.size() && !isBetter(c0[order[g]], c0[order[end]])) ++end;
+            for (size_t k = g; k < end; ++k) {
+                uint32_t r = order[k];
+                onFront[r] = !hasBest || (c1 && !isBetter(best1, c1[r]));
+            }
+            if (!c1) return;  // only the best group is left undominated
+            for (size_t k = g; k < end; ++k) {
+                if (!hasBest || isBetter(c1[order[k]], best1)) best1 = c1[order[k]];
+                hasBest = true;
+            }
+            g = end;
+        }
+    }
+
+    // Moves the front of rows[0, n) (sorted on the first objective) to its beginning and
+    // returns its size
+    static size_t kung(const ObjectiveMatrix &obj, const Comparator &isBetter, uint32_t *rows,
+                       size_t n) {
+        if (n <= 1) return n;
+        const size_t half = n / 2;
+        const size_t nbTop = kung(obj, isBetter, rows, half);
+        const size_t nbBottom = kung(obj, isBetter, rows + half, n - half);
+        // rows of the bottom half can't dominate those of the top half
+        size_t nbFront = nbTop;
+        for (size_t b = half; b < half + nbBottom; ++b) {
+            bool dominated = false;
+            for (size_t t = 0; t < nbTop && !dominated; ++t)
+                dominated = dominates(obj, rows[t], rows[b], isBetter);
+            if (!dominated) rows[nbFront++] = rows[b];
+        }
+        return nbFront;
+    }
+};
+
+/*****************************************************************************
+ *                         NSGA-II SORTING
+ * **************************************************************************/
+// Result of a non-dominated sort, indexed by population slot.
+struct ParetoRanking {
+    vector<int> rank;                 // front of each slot, starting at 1
+    vector<double> crowding;          // crowding distance of each slot within its front
+    vector<vector<uint32_t>> fronts;  // slots of each front
+
+    size_t size() const { return rank.size(); }
+
+    // crowded comparison: lower rank wins, then larger crowding distance.
+    // Returns 1 if a wins, -1 if b wins and 0 if they can't be told apart.
+    int compare(size_t a, size_t b) const {
+        if (rank[a] < rank[b]) return 1;
+        if (rank[b] < rank[a]) return -1;
+        if (crowding[a] > crowding[b]) return 1;
+        if (crowding[b] > crowding[a]) return -1;
+        return 0;
+    }
+
+    // Ranking of the given slots, in this order (e.g. the survivors of a truncation).
+    // Ranks and distances are kept as they are, not recomputed.
+    ParetoRanking subset(const vector<size_t> &slots) const {
+        ParetoRanking res;
+        subset(slots, res);
+        return res;
+    }
+    // same, written into res (another ranking), whose vectors keep their storage
+    void subset(const vector<size_t> &slots, ParetoRanking &res) const {
+        assert(&res != this);
+        vector<uint32_t> newSlot(size(), std::numeric_limits<uint32_t>::max());
+        res.rank.resize(slots.size());
+        res.crowding.resize(slots.size());
+        for (size_t k = 0; k < slots.size(); ++k) {
+            newSlot[slots[k]] = static_cast<uint32_t>(k);
+            res.rank[k] = rank[slots[k]];
+            res.crowding[k] = crowding[slots[k]];
+        }
+        size_t nbFronts = 0;
+        for (const auto &f : fronts) {
+            if (res.fronts.size() == nbFronts) res.fronts.emplace_back();
+            auto &kept = res.fronts[nbFronts];
+            kept.clear();
+            for (auto i : f)
+                if (newSlot[i] != std::numeric_limits<uint32_t>::max()) kept.push_back(newSlot[i]);
+            if (!kept.empty()) ++nbFronts;
+        }
+        res.fronts.resize(nbFronts);
+    }
+};
+
+// Fast non-dominated sort and crowding distances of NSGA-II, on the rows of an objective
+// matrix. All the scratch data is index based and owned by the sorter: it keeps its
+// capacity from one sort to the next, and separate sorters can be used concurrently.
+class NSGA2Sorter {
+ public:
+    using Comparator = std::function<bool(double, double)>;
+
+    // 1 if row a dominates row b, -1 if b dominates a, 0 otherwise
+    static int dominates(const ObjectiveMatrix &obj, size_t a, size_t b,
+                         const Comparator &isBetter) {
+        int a_dominates = 0;
+        int b_dominates = 0;
+        for (size_t o = 0; o < obj.nbObjectives(); ++o) {
+            double fit_a = obj(a, o);
+            double fit_b = obj(b, o);
+            if (isBetter(fit_a, fit_b))
+                a_dominates = 1;
+            else if (isBetter(fit_b, fit_a))
+                b_dominates = 1;
+        }
+        if (a_dominates > b_dominates) return 1;
+        if (a_dominates < b_dominates) return -1;
+        return 0;
+    }
+
+    // Domination data for rows [begin, end): dominationCounts()[p - begin] is the number of
+    // rows dominating p, dominatedSets()[p - begin] the (increasing) rows p dominates.
+    void computeDominations(const ObjectiveMatrix &obj, size_t begin, size_t end,
+                            const Comparator &isBetter) {
+        GAGA_TRACE_SPAN("dominations");
+        np.assign(end - begin, 0);
+        sp.resize(end - begin);
+#ifdef OMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+        for (size_t pid = begin; pid < end; ++pid) {
+            auto &dominated = sp[pid - begin];
+            dominated.clear();
+            for (size_t qid = 0; qid < obj.nbRows; ++qid) {
+                if (pid == qid) continue;
+                int cmp = dominates(obj, pid, qid, isBetter);
+                if (cmp > 0)
+                    dominated.push_back(static_cast<uint32_t>(qid));
+                else if (cmp < 0)
+                    ++np[pid - begin];
+            }
+        }
+    }
+    vector<int> &dominationCounts() { return np; }
+    vector<vector<uint32_t>> &dominatedSets() { return sp; }
+
+    // Peels the fronts off the domination data of all the rows (the counts are consumed),
+    // then computes the crowding distances.
+    void rank(const ObjectiveMatrix &obj, const Comparator &isBetter, ParetoRanking &res) {
+        const size_t n = obj.nbRows;
+        assert(np.size() == n && sp.size() == n);
+        res.rank.assign(n, 0);
+        res.crowding.assign(n, 0.0);
+        // fronts are built in the vectors of res's previous fronts, kept with the spare ones
+        for (auto &f : res.fronts) spareFronts.push_back(std::move(f));
+        res.fronts.clear();
+        auto newFront = [&]() -> vector<uint32_t> & {
+            res.fronts.emplace_back();
+            if (!spareFronts.empty()) {
+                res.fronts.back().swap(spareFronts.back());
+                spareFronts.pop_back();
+                res.fronts.back().clear();
+            }
+            return res.fronts.back();
+        };
+        auto &first = newFront();
+        for (size_t pid = 0; pid < n; ++pid) {
+            if (np[pid] == 0) {
+                first.push_back(static_cast<uint32_t>(pid));
+                res.rank[pid] = 1;
+            }
+        }
+        for (size_t f = 0; !res.fronts[f].empty(); ++f) {
+            auto &next = newFront();
+            for (auto p : res.fronts[f]) {
+                for (auto q : sp[p]) {
+                    if (--np[q] == 0) {
+                        res.rank[q] = static_cast<int>(f) + 2;
+                        next.push_back(q);
+                    }
+                }
+            }
+        }
+        spareFronts.push_back(std::move(res.fronts.back()));  // the empty one
+        res.fronts.pop_back();
+        crowding(obj, isBetter, res);
+    }
+
+    // both steps on the whole matrix
+    void sort(const ObjectiveMatrix &obj, const Comparator &isBetter, ParetoRanking &res) {
+        computeDominations(obj, 0, obj.nbRows, isBetter);
+        rank(obj, isBetter, res);
+    }
+
+ protected:
+    vector<int> np;
+    vector<vector<uint32_t>> sp;
+    vector<double> contributions;                // [o * nbRows + row]
+    vector<std::pair<double, uint32_t>> sorted;  // [o * nbRows + frontStart + k]
+    vector<size_t> frontStarts;
+    vector<vector<uint32_t>> spareFronts;  // vectors of former fronts (see rank)
+
+    // Crowding distances of every front. Each (front, objective) pair is an independent
+    // task: the objective's values of the front are copied next to their rows and sorted
+    // (ties by row), and the normalised gaps around each row are written to its
+    // contribution for that objective. The distance of a row is then the sum of its
+    // contributions. Fronts are left untouched.
+    void crowding(const ObjectiveMatrix &obj, const Comparator &isBetter, ParetoRanking &res) {
+        GAGA_TRACE_SPAN("crowding");
+        const size_t n = obj.nbRows;
+        const size_t nbObj = obj.nbObjectives();
+        const size_t nbFronts = res.fronts.size();
+        const double inf = std::numeric_limits<double>::infinity();
+        contributions.assign(nbObj * n, 0.0);
+        sorted.resize(nbObj * n);
+        frontStarts.resize(nbFronts);
+        size_t start = 0;
+        for (size_t f = 0; f < nbFronts; ++f) {
+            frontStarts[f] = start;
+            start += res.fronts[f].size();
+        }
+#ifdef OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (size_t t = 0; t < nbFronts * nbObj; ++t) {
+            const size_t f = t / nbObj;
+            const size_t o = t % nbObj;
+            const auto &front = res.fronts[f];
+            const size_t m = front.size();
+            const double *col = obj.column(o);
+            auto *v = &sorted[o * n + frontStarts[f]];
+            for (size_t k = 0; k < m; ++k) v[k] = {col[front[k]], front[k]};
+            std::sort(v, v + m, [&](const std::pair<double, uint32_t> &a,
+                                    const std::pair<double, uint32_t> &b) {
+                if (isBetter(a.first, b.first)) return true;
+                if (isBetter(b.first, a.first)) return false;
+                return a.second < b.second;
+            });
+            double *c = &contributions[o * n];
+            c[v[0].second] = inf;
+            c[v[m - 1].second] = inf;
+            const double denom = v[m - 1].first - v[0].first;
+            if (denom == 0.0) continue;  // all equal: no information on this objective
+            for (size_t k = 1; k + 1 < m; ++k)
+                c[v[k].second] = (v[k + 1].first - v[k - 1].first) / denom;
+        }
+#ifdef OMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (size_t i = 0; i < n; ++i) {
+            double d = 0.0;
+            for (size_t o = 0; o < nbObj; ++o) d += contributions[o * n + i];
+            res.crowding[i] = d;
+        }
+    }
+};
+
+/*****************************************************************************
+ *                         TOURNAMENT SELECTION
+ * **************************************************************************/
+// Tournament policies, used by TournamentSelector. A policy picks the winner among the k
+// participants (rows of an objective matrix) of a tournament and declares how many uniform
+// numbers in [0, 1) it needs per tournament; they are drawn with the participants, before
+// any tournament is run:
+//   static constexpr size_t nbUniforms;
+//   static uint32_t winner(const ObjectiveMatrix &, const uint32_t *participants, size_t k,
+//                          const Comparator &isBetter, const double *uniforms);
+
+// A random participant of the Pareto front of the tournament (see ParetoFrontExtractor).
+struct ParetoTournamentPolicy {
+    using Comparator = std::function<bool(double, double)>;
+    static constexpr size_t nbUniforms = 1;
+
+    static bool dominates(const ObjectiveMatrix &obj, uint32_t a, uint32_t b,
+                          const Comparator &isBetter) {
+        return ParetoFrontExtractor::dominates(obj, a, b, isBetter);
+    }
+    static bool inFront(const ObjectiveMatrix &obj, const uint32_t *p, size_t k, size_t i,
+                        const Comparator &isBetter) {
+        for (size_t j = 0; j < k; ++j)
+            if (j != i && dominates(obj, p[j], p[i], isBetter)) return false;
+        return true;
+    }
+    static uint32_t winner(const ObjectiveMatrix &obj, const uint32_t *p, size_t k,
+                           const Comparator &isBetter, const double *u) {
+        // counts the front, then walks it again up to the drawn member: no scratch needed
+        size_t frontSize = 0;
+        for (size_t i = 0; i < k; ++i) frontSize += inFront(obj, p, k, i, isBetter);
+        assert(frontSize > 0);
+        size_t m = std::min(static_cast<size_t>(u[0] * static_cast<double>(frontSize)),
+                            frontSize - 1);
+        for (size_t i = 0; i < k; ++i)
+            if (inFront(obj, p, k, i, isBetter) && m-- == 0) return p[i];
+        return p[0];
+    }
+};
+
+// The best participant on a random objective (the first one wins ties).
+struct RandomObjTournamentPolicy {
+    using Comparator = std::function<bool(double, double)>;
+    static constexpr size_t nbUniforms = 1;
+
+    static uint32_t winner(const ObjectiveMatrix &obj, const uint32_t *p, size_t k,
+                           const Comparator &isBetter, const double *u) {
+        const size_t nbObj = obj.nbObjectives();
+        assert(nbObj > 0);
+        const size_t o = std::min(static_cast<size_t>(u[0] * static_cast<double>(nbObj)),
+                                  nbObj - 1);
+        const double *col = obj.column(o);
+        uint32_t champion = p[0];
+        for (size_t i = 1; i < k; ++i)
+            if (isBetter(col[p[i]], col[champion])) champion = p[i];
+        return champion;
+    }
+};
+
+// Runs all the tournaments of a generation at once. The participants and the policy's
+// uniforms of every tournament are drawn first, in one pass over the random engine, so the
+// winners only depend on its state, and the tournaments themselves can then run in
+// parallel. Scratch buffers keep their capacity from one call to the next.
+class TournamentSelector {
+ public:
+    using Comparator = std::function<bool(double, double)>;
+
+    // winners[t] is the row of obj that won the t-th of nbTournaments tournaments
+    template <typename Policy>
+    void select(const ObjectiveMatrix &obj, size_t tournamentSize, size_t nbTournaments,
+                const Comparator &isBetter, RandomEngine &rng, vector<uint32_t> &winners,
+                bool parallel = false) {
+        assert(obj.nbRows > 0 && tournamentSize > 0);
+        const size_t k = tournamentSize;
+        const size_t nu = Policy::nbUniforms;
+        participants.resize(nbTournaments * k);
+        uniforms.resize(nbTournaments * nu);
+        std::uniform_int_distribution<uint32_t> dRow(0, static_cast<uint32_t>(obj.nbRows - 1));
+        std::uniform_real_distribution<double> dUnif(0.0, 1.0);
+        for (auto &p : participants) p = dRow(rng);
+        for (auto &u : uniforms) u = dUnif(rng);
+        winners.resize(nbTournaments);
+        (void)parallel;
+#ifdef OMP
+#pragma omp parallel for schedule(static) if (parallel)
+#endif
+        for (size_t t = 0; t < nbTournaments; ++t)
+            winners[t] =
+                Policy::winner(obj, &participants[t * k], k, isBetter, &uniforms[t * nu]);
+    }
+
+ protected:
+    vector<uint32_t> participants;
+    vector<double> uniforms;
+};
+
+/*****************************************************************************
+ *                               ELITES
+ * **************************************************************************/
+// The n best rows of each objective of a matrix, best first.
+struct EliteSet {
+    vector<string> objectives;      // names of the objectives, as in the matrix
+    vector<vector<uint32_t>> rows;  // rows[o]: best rows on objective o
+
+    size_t size(size_t o) const { return rows[o].size(); }
+};
+
+// Partial selection (nth_element, then a sort of the n selected rows) on an index array per
+// objective, the objectives being handled in parallel. Ties are broken by row index, so the
+// elites don't depend on the standard library's implementation. The index arrays keep
+// their capacity from one call to the next.
+class EliteSelector {
+ public:
+    using Comparator = std::function<bool(double, double)>;
+
+    void select(const ObjectiveMatrix &obj, size_t n, const Comparator &isBetter,
+                EliteSet &res) {
+        const size_t nbObj = obj.nbObjectives();
+        n = std::min(n, obj.nbRows);
+        res.objectives = obj.names;
+        res.rows.resize(nbObj);
+        order.resize(nbObj);
+#ifdef OMP
+#pragma omp parallel for schedule(dynamic, 1) if (nbObj > 1)
+#endif
+        for (size_t o = 0; o < nbObj; ++o) {
+            auto &idx = order[o];
+            idx.resize(obj.nbRows);
+            for (size_t i = 0; i < idx.size(); ++i) idx[i] = static_cast<uint32_t>(i);
+            const double *col = obj.column(o);
+            auto better = [&](uint32_t a, uint32_t b) {
+                if (isBetter(col[a], col[b])) return true;
+                if (isBetter(col[b], col[a])) return false;
+                return a < b;
+            };
+            if (n < idx.size()) std::nth_element(idx.begin(), idx.begin() + n, idx.end(), better);
+            std::sort(idx.begin(), idx.begin() + n, better);
+            res.rows[o].assign(idx.begin(), idx.begin() + n);
+        }
+    }
+
+ protected:
+    vector<vector<uint32_t>> order;
+};
+
+/*****************************************************************************
+ *                         DISTRIBUTED SCHEDULING
+ * **************************************************************************/
+// Transport agnostic bookkeeping of a distributed evaluation round: which tasks
+// (individual indices) are still pending, which worker is evaluating what, and when each
+// worker was last heard of. Workers pull batches of tasks. A worker that stays silent for
+// longer than the timeout while it should be working is declared lost, and its batch goes
+// back to the queue for the next worker asking for work. Workers can join (or come back)
+// and leave at any moment; the first result received for a task wins.
+class EvalScheduler {
+ public:
+    using clock = std::chrono::steady_clock;
+
+    explicit EvalScheduler(size_t bSize = 1, double tOut = 60.0)
+        : batchSize(bSize), timeout(tOut) {}
+
+    void setBatchSize(size_t s) { batchSize = s > 0 ? s : 1; }
+    void setTimeout(double s) { timeout = s; }
+
+    // starts a new round with nbTasks tasks. Known workers stay alive (and waiting if
+    // they were), and get a full timeout to show up.
+    void newRound(size_t nbTasks, clock::time_point now) {
+        pending.clear();
+        for (size_t i = 0; i < nbTasks; ++i) pending.push_back(i);
+        done.assign(nbTasks, false);
+        nbTasksDone = 0;
+        for (auto &w : workers) {
+            w.second.batch.clear();
+            w.second.lastSeen = now;
+        }
+    }
+
+    // a worker shows up: new one, or a lost one coming back
+    void join(int w, clock::time_point now) {
+        auto &wk = workers[w];
+        wk.alive = true;
+        wk.lastSeen = now;
+    }
+
+    // a worker leaves (or is known to be dead): its unfinished tasks are requeued
+    void leave(int w) {
+        auto it = workers.find(w);
+        if (it == workers.end()) return;
+        requeue(it->second);
+        workers.erase(it);
+    }
+
+    // a waiting worker was told there's nothing left: it's expected to ask again
+    void dismiss(int w) {
+        auto it = workers.find(w);
+        if (it != workers.end()) it->second.waiting = false;
+    }
+
+    void heartbeat(int w, clock::time_point now) {
+        auto it = workers.find(w);
+        if (it != workers.end() && it->second.alive) it->second.lastSeen = now;
+    }
+
+    // next batch of tasks for worker w. An empty batch means nothing is left for now:
+    // the worker is then considered waiting (for more work or for the end of the round)
+    vector<size_t> assign(int w, clock::time_point now) {
+        join(w, now);
+        auto &wk = workers[w];
+        wk.batch = takePending();
+        wk.waiting = wk.batch.empty();
+        return wk.batch;
+    }
+
+    // tasks reported as evaluated by w. Returns those that weren't already done (only
+    // the results of these should be kept)
+    vector<size_t> complete(int w, const vector<size_t> &tasks, clock::time_point now) {
+        join(w, now);
+        auto &b = workers[w].batch;
+        for (auto t : tasks) b.erase(std::remove(b.begin(), b.end(), t), b.end());
+        return markDone(tasks);
+    }
+
+    // tasks the coordinator evaluates itself (when no worker is left)
+    vector<size_t> takeLocal() { return takePending(); }
+    void completeLocal(const vector<size_t> &tasks) { markDone(tasks); }
+
+    // declares lost every busy worker that has been silent for too long
+    vector<int> expire(clock::time_point now) {
+        vector<int> lost;
+        for (auto &w : workers) {
+            auto &wk = w.second;
+            if (!wk.alive || wk.waiting) continue;
+            if (std::chrono::duration<double>(now - wk.lastSeen).count() > timeout) {
+                wk.alive = false;
+                requeue(wk);
+                lost.push_back(w.first);
+            }
+        }
+        return lost;
+    }
+
+    // every worker ever seen and not gone, lost or not
+    vector<int> knownWorkers() const {
+        vector<int> res;
+        for (auto &w : workers) res.push_back(w.first);
+        return res;
+    }
+
+    vector<int> waitingWorkers() const {
+        vector<int> res;
+        for (auto &w : workers)
+            if (w.second.alive && w.second.waiting) res.push_back(w.first);
+        return res;
+    }
+
+    bool isAlive(int w) const {
+        auto it = workers.find(w);
+        return it != workers.end() && it->second.alive;
+    }
+
+    size_t nbAlive() const {
+        size_t n = 0;
+        for (auto &w : workers) n += w.second.alive ? 1 : 0;
+        return n;
+    }
+
+    size_t nbWorkers() const { return workers.size(); }
+    size_t nbPending() const { return pending.size(); }
+    size_t nbDone() const { return nbTasksDone; }
+    bool finished() const { return nbTasksDone == done.size(); }
+
+ protected:
+    struct Worker {
+        bool alive = true;
+        bool waiting = false;  // asked for work and got none: not expected to talk
+        clock::time_point lastSeen;
+        vector<size_t> batch;  // tasks given and not reported yet
+    };
+
+    size_t batchSize;
+    double timeout;  // in seconds
+    std::map<int, Worker> workers;
+    std::deque<size_t> pending;
+    vector<bool> done;
+    size_t nbTasksDone = 0;
+
+    vector<size_t> takePending() {
+        vector<size_t> res;
+        while (res.size() < batchSize && !pending.empty()) {
+            size_t t = pending.front();
+            pending.pop_front();
+            if (!done[t]) res.push_back(t);  // could have been done by a lost worker
+        }
+        return res;
+    }
+
+    vector<size_t> markDone(const vector<size_t> &tasks) {
+        vector<size_t> accepted;
+        for (auto t : tasks) {
+            if (t < done.size() && !done[t]) {
+                done[t] = true;
+                ++nbTasksDone;
+                accepted.push_back(t);
+            }
+        }
+        return accepted;
+    }
+
+    void requeue(Worker &wk) {
+        for (auto it = wk.batch.rbegin(); it != wk.batch.rend(); ++it)
+            if (!done[*it]) pending.push_front(*it);
+        wk.batch.clear();
+    }
+};
+
+#ifdef SOCKET_WORKERS
+/*****************************************************************************
+ *                           SOCKET TRANSPORT
+ * **************************************************************************/
+// Minimal framed protocol over TCP or Unix domain sockets, used to hand evaluations to
+// long lived worker processes (see GA::enableSocketWorkers and GA::runWorker).
+// Addresses are "tcp://host:port" or "unix:///path/to/socket".
+// A frame is [uint32 type][uint64 payload size][payload], in native byte order.
+class Socket {
+ public:
+    enum Frame : uint32_t { REQUEST = 1, BATCH, RESULTS, HEARTBEAT, BYE };
+
+    Socket() {}
+    explicit Socket(int f) : fd(f) {}
+    ~Socket() { close(); }
+    Socket(const Socket &) = delete;
+    Socket &operator=(const Socket &) = delete;
+    Socket(Socket &&o) noexcept : fd(o.fd), inbox(std::move(o.inbox)) { o.fd = -1; }
+    Socket &operator=(Socket &&o) noexcept {
+        if (this != &o) {
+            close();
+            fd = o.fd;
+            inbox = std::move(o.inbox);
+            o.fd = -1;
+        }
+        return *this;
+    }
+
+    int handle() const { return fd; }
+    bool valid() const { return fd >= 0; }
+    void close() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    // non blocking listening socket
+    static Socket listen(const string &address) {
+        auto a = resolve(address);
+        if (a.addr.ss_family == AF_UNIX)
+            ::unlink(reinterpret_cast<sockaddr_un *>(&a.addr)->sun_path);
+        Socket s(::socket(a.addr.ss_family, SOCK_STREAM, 0));
+        int one = 1;
+        if (a.addr.ss_family != AF_UNIX)
+            ::setsockopt(s.fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (!s.valid() || ::bind(s.fd, reinterpret_cast<sockaddr *>(&a.addr), a.len) < 0 ||
+            ::listen(s.fd, SOMAXCONN) < 0)
+            throw std::runtime_error("Cannot listen on " + address + ": " + strerror(errno));
+        ::fcntl(s.fd, F_SETFL, ::fcntl(s.fd, F_GETFL) | O_NONBLOCK);
+        return s;
+    }
+
+    static Socket connect(const string &address) {
+        auto a = resolve(address);
+        Socket s(::socket(a.addr.ss_family, SOCK_STREAM, 0));
+        if (!s.valid() || ::connect(s.fd, reinterpret_cast<sockaddr *>(&a.addr), a.len) < 0)
+            throw std::runtime_error("Cannot connect to " + address + ": " + strerror(errno));
+        s.noDelay();
+        return s;
+    }
+
+    // returns an invalid socket if nobody is waiting
+    Socket accept() {
+        Socket s(::accept(fd, nullptr, nullptr));
+        if (s.valid()) s.noDelay();
+        return s;
+    }
+
+    // returns false if the peer is gone
+    bool send(uint32_t type, const string &payload) {
+        string frame;
+        frame.reserve(headerSize + payload.size());
+        binaryPut(frame, type);
+        binaryPut(frame, static_cast<uint64_t>(payload.size()));
+        frame += payload;
+        size_t sent = 0;
+        while (sent < frame.size()) {
+            auto n = ::send(fd, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // blocks until a whole frame is received. Returns false if the peer is gone
+    bool receive(uint32_t &type, string &payload) {
+        while (!pop(type, payload)) {
+            char buf[1 << 16];
+            auto n = ::recv(fd, buf, sizeof(buf), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            inbox.append(buf, static_cast<size_t>(n));
+        }
+        return true;
+    }
+
+    // reads whatever is available without blocking. Returns false if the peer is gone
+    bool fill() {
+        for (;;) {
+            char buf[1 << 16];
+            auto n = ::recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+            if (n > 0) {
+                inbox.append(buf, static_cast<size_t>(n));
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+            }
+        }
+    }
+
+    // extracts the next complete frame received, if any
+    bool pop(uint32_t &type, string &payload) {
+        if (inbox.size() < headerSize) return false;
+        const char *cur = inbox.data();
+        type = binaryGet<uint32_t>(cur, cur + headerSize);
+        auto size = binaryGet<uint64_t>(cur, cur + sizeof(uint64_t));
+        if (inbox.size() - headerSize < size) return false;
+        payload.assign(inbox, headerSize, size);
+        inbox.erase(0, headerSize + size);
+        return true;
+    }
+
+ protected:
+    static constexpr size_t headerSize = sizeof(uint32_t) + sizeof(uint64_t);
+    int fd = -1;
+    string inbox;  // received bytes that don't make a whole frame yet
+
+    struct Address {
+        sockaddr_storage addr;
+        socklen_t len;
+    };
+
+    static Address resolve(const string &address) {
+        Address a;
+        std::memset(&a.addr, 0, sizeof(a.addr));
+        if (address.compare(0, 7, "unix://") == 0) {
+            auto *un = reinterpret_cast<sockaddr_un *>(&a.addr);
+            string path = address.substr(7);
+            if (path.size() >= sizeof(un->sun_path))
+                throw std::invalid_argument("Socket path too long: " + path);
+            un->sun_family = AF_UNIX;
+            std::strcpy(un->sun_path, path.c_str());
+            a.len = sizeof(sockaddr_un);
+            return a;
+        }
+        auto colon = address.rfind(':');
+        if (address.compare(0, 6, "tcp://") != 0 || colon < 6)
+            throw std::invalid_argument("Invalid address " + address +
+                                        " (expected tcp://host:port or unix:///path)");
+        string host = address.substr(6, colon - 6), port = address.substr(colon + 1);
+        addrinfo hints, *res = nullptr;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+        if (::getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &res) ||
+            !res)
+            throw std::invalid_argument("Cannot resolve " + address);
+        std::memcpy(&a.addr, res->ai_addr, res->ai_addrlen);
+        a.len = res->ai_addrlen;
+        ::freeaddrinfo(res);
+        return a;
+    }
+
+    void noDelay() {  // fails harmlessly on Unix sockets
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+};
+#endif
+
+/*****************************************************************************
+ *                         GENERATION STATISTICS
+ * **************************************************************************/
+// category ("global" or an objective) -> {stat name -> value}
+using GenStats = std::map<std::string, std::map<std::string, double>>;
+
+// Keeps the last `capacity` values pushed, addressed by their absolute index: the first
+// value ever pushed (or the first one after reset(first)) has index first.
+template <typename T> class RingBuffer {
+ public:
+    explicit RingBuffer(size_t c = 1000) : cap(c > 0 ? c : 1) {}
+
+    void push_back(T v) {
+        if (data.size() < cap) {
+            data.push_back(std::move(v));
+        } else {
+            data[head] = std::move(v);
+            head = (head + 1) % cap;
+        }
+        ++end;
+    }
+    // keeps the most recent values
+    void setCapacity(size_t c) {
+        vector<T> kept;
+        c = c > 0 ? c : 1;
+        for (size_t i = std::max(firstIndex(), end - std::min(end, c)); i < end; ++i)
+            kept.push_back(std::move((*this)[i]));
+        data = std::move(kept);
+        cap = c;
+        head = 0;
+    }
+    void reset(size_t first = 0) {
+        data.clear();
+        head = 0;
+        end = first;
+    }
+
+    size_t capacity() const { return cap; }
+    size_t size() const { return data.size(); }
+    bool empty() const { return data.empty(); }
+    size_t firstIndex() const { return end - data.size(); }
+    size_t endIndex() const { return end; }
+    bool contains(size_t i) const { return i >= firstIndex() && i < end; }
+
+    T &operator[](size_t i) { return data[(head + i - firstIndex()) % data.size()]; }
+    const T &operator[](size_t i) const { return data[(head + i - firstIndex()) % data.size()]; }
+    T &at(size_t i) {
+        if (!contains(i)) throw std::out_of_range("Value no longer (or not yet) in the buffer");
+        return (*this)[i];
+    }
+    const T &at(size_t i) const {
+        if (!contains(i)) throw std::out_of_range("Value no longer (or not yet) in the buffer");
+        return (*this)[i];
+    }
+    T &back() { return (*this)[end - 1]; }
+    const T &back() const { return (*this)[end - 1]; }
+
+ protected:
+    vector<T> data;
+    size_t cap;
+    size_t head = 0;  // slot of the oldest value, once the buffer is full
+    size_t end = 0;
+};
+
+// Append-only CSV of the generations' stats: one row per generation, columns
+// "category_stat". The header is written once; if new columns appear later (e.g. an
+// objective is added during the run), a new header line with all the columns seen so far
+// is written before the row, so each line starting with "generation" opens a new
+// section. Missing values are left empty. Rows are buffered and flushed every
+// flushInterval rows, and when the writer is closed.
+class GenStatsWriter {
+ public:
+    ~GenStatsWriter() { close(); }
+
+    // Starts a file, or appends to the one already there. When appending, the rows of
+    // generations from fromGeneration on (e.g. written after the checkpoint that is being
+    // resumed), the header lines after the last row kept and an incomplete line are dropped.
+    void open(const string &path, bool append = false,
+              size_t fromGeneration = std::numeric_limits<size_t>::max()) {
+        close();
+        if (append && fs::exists(path)) fs::resize_file(path, keptSize(path, fromGeneration));
+        file.open(path, append ? std::ios::app : std::ios::trunc);
+        if (!file) cerr << "Cannot open " << path << endl;
+        columns.clear();
+        pendingRows = 0;
+    }
+    void close() {
+        if (file.is_open()) file.close();
+    }
+    bool isOpen() const { return file.is_open(); }
+    void setFlushInterval(size_t n) { flushInterval = n > 0 ? n : 1; }
+    void flush() {
+        file.flush();
+        pendingRows = 0;
+    }
+
+    void write(size_t generation, const GenStats &stats) {
+        bool newColumns = columns.empty();
+        for (const auto &cat : stats)
+            for (const auto &st : cat.second)
+                newColumns = columns.insert({cat.first, st.first}).second || newColumns;
+        if (newColumns) {
+            file << "generation";
+            for (const auto &c : columns) file << "," << c.first << "_" << c.second;
+            file << "\n";
+        }
+        file << generation;
+        for (const auto &c : columns) {
+            file << ",";
+            auto cat = stats.find(c.first);
+            if (cat == stats.end()) continue;
+            auto st = cat->second.find(c.second);
+            if (st != cat->second.end()) file << st->second;
+        }
+        file << "\n";
+        if (++pendingRows >= flushInterval) flush();
+    }
+
+ protected:
+    std::ofstream file;
+    std::set<std::pair<string, string>> columns;  // (category, stat), in map order
+    size_t flushInterval = 10;
+    size_t pendingRows = 0;
+
+    // size of the beginning of a file that only holds the rows before fromGeneration
+    static uint64_t keptSize(const string &path, size_t fromGeneration) {
+        std::ifstream in(path, std::ios::binary);
+        string line;
+        uint64_t pos = 0, kept = 0;
+        while (std::getline(in, line) && !in.eof()) {  // eof: no '\n', incomplete line
+            pos += line.size() + 1;
+            if (line.compare(0, 10, "generation") == 0) continue;
+            char *last = nullptr;
+            unsigned long long g = std::strtoull(line.c_str(), &last, 10);
+            if (last == line.c_str() || g >= fromGeneration) break;
+            kept = pos;
+        }
+        return kept;
+    }
+};
+
+// Per individual stats, in a columnar binary file: a header (magic, version, byte order
+// mark), then one block per generation:
+// [payload size][generation][nb rows][nb objectives][encoding][raw payload size][payload]
+// The payload holds the objective names (size prefixed strings), then the columns, each
+// padded to 8 bytes: one per objective (doubles, in names order), evalTime (doubles), id
+// (uint32) and onParetoFront (uint8). With the deflated encoding, the payload is compressed
+// with zlib (only written when gaga is built with ZLIB). Native byte order, like the other
+// binary files. A block is written whole, so readers ignore an incomplete last block.
+// tools/indstats.py reads these files without any dependency.
+struct IndStatsBlock {
+    uint64_t generation = 0;
+    vector<string> objectives;
+    vector<vector<double>> fitnesses;  // one column per objective
+    vector<double> evalTimes;
+    vector<uint32_t> ids;
+    vector<uint8_t> onParetoFront;
+};
+
+struct IndStatsFormat {
+    static constexpr uint32_t version = 1;
+    static constexpr size_t magicSize = 8;
+    static constexpr uint32_t raw = 0, deflated = 1;  // payload encodings
+    static const char *magic() { return "GAGAIST"; }  // with its trailing '\0'
+    static void pad(string &buf) { buf.resize((buf.size() + 7) / 8 * 8, '\0'); }
+
+    static string header() {
+        string h(magic(), magicSize);
+        binaryPut(h, uint32_t(version));
+        binaryPut(h, uint32_t(PopulationFile::byteOrderMark));
+        return h;
+    }
+
+    static string encodeBlock(size_t generation, const ObjectiveMatrix &obj,
+                              const vector<bool> &onFront, const vector<double> &evalTimes,
+                              bool compress) {
+        const size_t n = obj.nbRows;
+        string payload;
+        for (const auto &name : obj.names) binaryPut(payload, name);
+        auto putColumn = [&](const void *data, size_t bytes) {
+            pad(payload);
+            payload.append(static_cast<const char *>(data), bytes);
+        };
+        for (size_t o = 0; o < obj.nbObjectives(); ++o)
+            putColumn(obj.column(o), n * sizeof(double));
+        putColumn(evalTimes.data(), n * sizeof(double));
+        vector<uint32_t> ids(n);
+        for (size_t i = 0; i < n; ++i) ids[i] = static_cast<uint32_t>(i);
+        putColumn(ids.data(), n * sizeof(uint32_t));
+        vector<uint8_t> front(n);
+        for (size_t i = 0; i < n; ++i) front[i] = onFront[i];
+        putColumn(front.data(), n);
+        pad(payload);
+
+        const uint64_t rawSize = payload.size();
+        uint32_t encoding = raw;
+        if (compress) {
+#ifdef ZLIB
+            uLongf size = compressBound(payload.size());
+            string packed(size, '\0');
+            // stats are written every generation: favor speed
+            if (compress2(reinterpret_cast<Bytef *>(&packed[0]), &size,
+                          reinterpret_cast<const Bytef *>(payload.data()), payload.size(),
+                          Z_BEST_SPEED) != Z_OK)
+                throw std::runtime_error("Cannot compress individual stats");
+            packed.resize(size);
+            payload.swap(packed);
+            encoding = deflated;
+#else
+            throw std::invalid_argument("Compressed stats need gaga to be built with ZLIB");
+#endif
+        }
+        string block;
+        binaryPut(block, static_cast<uint64_t>(payload.size()));
+        binaryPut(block, static_cast<uint64_t>(generation));
+        binaryPut(block, static_cast<uint64_t>(n));
+        binaryPut(block, static_cast<uint32_t>(obj.nbObjectives()));
+        binaryPut(block, encoding);
+        binaryPut(block, rawSize);
+        block += payload;
+        return block;
+    }
+
+    // Calls f (if any) with each block of a file, and returns the size of its valid part.
+    // The blocks from the first one of generation endGeneration or later are left out.
+    static size_t read(const string &path,
+                       const std::function<void(IndStatsBlock &&)> &f = nullptr,
+                       uint64_t endGeneration = std::numeric_limits<uint64_t>::max()) {
+        MappedFile file(path);
+        const char *begin = file.data(), *end = begin + file.size(), *cur = begin;
+        if (file.size() < magicSize + 8 || !std::equal(begin, begin + magicSize, magic()))
+            throw std::runtime_error(path + " is not an individual stats file");
+        cur += magicSize;
+        if (binaryGet<uint32_t>(cur, end) > version)
+            throw std::runtime_error(path + " was written by a newer version of gaga");
+        if (binaryGet<uint32_t>(cur, end) != PopulationFile::byteOrderMark)
+            throw std::runtime_error(path + " was written with another byte order");
+        const size_t blockHeaderSize = 40;
+        while (static_cast<size_t>(end - cur) >= blockHeaderSize) {
+            const char *h = cur;
+            auto payloadSize = binaryGet<uint64_t>(h, end);
+            if (static_cast<uint64_t>(end - h) < blockHeaderSize - 8 + payloadSize) break;
+            IndStatsBlock b;
+            b.generation = binaryGet<uint64_t>(h, end);
+            if (b.generation >= endGeneration) break;
+            auto n = static_cast<size_t>(binaryGet<uint64_t>(h, end));
+            auto nbObj = binaryGet<uint32_t>(h, end);
+            auto encoding = binaryGet<uint32_t>(h, end);
+            auto rawSize = static_cast<size_t>(binaryGet<uint64_t>(h, end));
+            cur = h + payloadSize;
+            if (!f) continue;
+            string payload;
+            if (encoding == raw) {
+                if (rawSize != payloadSize)
+                    throw std::runtime_error("Corrupted individual stats in " + path);
+                payload.assign(h, static_cast<size_t>(payloadSize));
+            } else {
+#ifdef ZLIB
+                payload.resize(rawSize);
+                uLongf size = rawSize;
+                if (uncompress(reinterpret_cast<Bytef *>(&payload[0]), &size,
+                               reinterpret_cast<const Bytef *>(h), payloadSize) != Z_OK ||
+                    size != rawSize)
+                    throw std::runtime_error("Corrupted individual stats in " + path);
+#else
+                throw std::runtime_error(path +
+                                         " is compressed: gaga must be built with ZLIB to read it");
+#endif
+            }
+            const char *p = payload.data(), *pEnd = p + payload.size();
+            for (uint32_t o = 0; o < nbObj; ++o) b.objectives.push_back(binaryGetString(p, pEnd));
+            auto getColumn = [&](auto &column) {
+                p = payload.data() + (static_cast<size_t>(p - payload.data()) + 7) / 8 * 8;
+                column.resize(n);
+                size_t bytes = n * sizeof(column[0]);
+                if (static_cast<size_t>(pEnd - p) < bytes)
+                    throw std::runtime_error("Truncated individual stats block in " + path);
+                if (bytes) std::memcpy(&column[0], p, bytes);
+                p += bytes;
+            };
+            b.fitnesses.resize(nbObj);
+            for (auto &column : b.fitnesses) getColumn(column);
+            getColumn(b.evalTimes);
+            getColumn(b.ids);
+            getColumn(b.onParetoFront);
+            f(std::move(b));
+        }
+        return static_cast<size_t>(cur - begin);
+    }
+};
+
+// Appends blocks to an individual stats file. Only used by one thread at a time.
+class IndStatsWriter {
+ public:
+    ~IndStatsWriter() { close(); }
+
+    // Starts a file, or appends to the one already there. When appending, an incomplete
+    // last block and the blocks of generations from fromGeneration on are dropped.
+    void open(const string &path, bool append = false,
+              uint64_t fromGeneration = std::numeric_limits<uint64_t>::max()) {
+        close();
+        if (append && fs::exists(path) && fs::file_size(path) > 0) {
+            fs::resize_file(path, IndStatsFormat::read(path, nullptr, fromGeneration));
+            file.open(path, std::ios::binary | std::ios::app);
+        } else {
+            file.open(path, std::ios::binary | std::ios::trunc);
+            auto h = IndStatsFormat::header();
+            file.write(h.data(), static_cast<std::streamsize>(h.size()));
+        }
+        if (!file) cerr << "Cannot open " << path << endl;
+    }
+    void close() {
+        if (file.is_open()) file.close();
+    }
+    bool isOpen() const { return file.is_open(); }
+    bool isCompressed() const { return compress; }
+    void setCompression(bool c) {
+#ifndef ZLIB
+        if (c) throw std::invalid_argument("Compressed stats need gaga to be built with ZLIB");
+#endif
+        compress = c;
+    }
+
+    void write(size_t generation, const ObjectiveMatrix &obj, const vector<bool> &onFront,
+               const vector<double> &evalTimes) {
+        auto block = IndStatsFormat::encodeBlock(generation, obj, onFront, evalTimes, compress);
+        file.write(block.data(), static_cast<std::streamsize>(block.size()));
+        file.flush();
+    }
+
+ protected:
+    std::ofstream file;
+    bool compress = false;
+};
+
+/*****************************************************************************
+ *                               ASYNC I/O
+ * **************************************************************************/
+// Runs jobs (typically: serialise a snapshot and write it) in submission order on a
+// dedicated thread. At most maxPending jobs wait in the queue: submit() blocks until there
+// is room, so that a slow disk slows the run down instead of piling up snapshots. When
+// disabled, jobs run in the calling thread.
+class AsyncWriter {
+ public:
+    using Job = std::function<void()>;
+
+    ~AsyncWriter() { stop(); }
+
+    void setEnabled(bool e) {
+        if (!e) stop();
+        enabled = e;
+    }
+    bool isEnabled() const { return enabled; }
+    void setMaxPending(size_t n) {
+        std::lock_guard<std::mutex> lock(mutex);
+        maxPending = n > 0 ? n : 1;
+    }
+
+    // Without the I/O thread, the job runs right away and its exceptions reach the caller.
+    // On the thread, the first exception is kept and rethrown by drain() or rethrow().
+    void submit(Job job) {
+        if (!enabled) {
+            GAGA_TRACE_SPAN("save job");
+            job();
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!worker.joinable()) {
+            stopping = false;
+            worker = std::thread([this]() { loop(); });
+        }
+        notFull.wait(lock, [&]() { return jobs.size() < maxPending; });
+        jobs.push_back(std::move(job));
+        notEmpty.notify_one();
+    }
+
+    // blocks until every submitted job is done, then rethrows the failure of one, if any
+    void drain() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            idle.wait(lock, [&]() { return jobs.empty() && !busy; });
+        }
+        rethrow();
+    }
+
+    // rethrows (once) the first exception of a job run on the thread
+    void rethrow() {
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::swap(e, failure);
+        }
+        if (e) std::rethrow_exception(e);
+    }
+
+    // runs the remaining jobs, then stops the thread (the next submit restarts it). Doesn't
+    // throw: their failure is left for rethrow()
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        notEmpty.notify_all();
+        if (worker.joinable()) worker.join();
+    }
+
+ protected:
+    bool enabled = false;
+    size_t maxPending = 2;
+    std::deque<Job> jobs;
+    bool busy = false;
+    bool stopping = false;
+    std::exception_ptr failure;  // first exception of a job run on the thread
+    std::mutex mutex;
+    std::condition_variable notEmpty, notFull, idle;
+    std::thread worker;
+
+    void loop() {
+#ifdef TRACING
+        Tracer::get().setThreadName("I/O");
+#endif
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            notEmpty.wait(lock, [&]() { return !jobs.empty() || stopping; });
+            if (jobs.empty()) return;
+            Job job = std::move(jobs.front());
+            jobs.pop_front();
+            busy = true;
+            notFull.notify_one();
+            lock.unlock();
+            std::exception_ptr e;
+            try {
+                GAGA_TRACE_SPAN("save job");
+                job();
+            } catch (...) {
+                e = std::current_exception();
+            }
+            lock.lock();
+            if (e && !failure) failure = e;
+            busy = false;
+            if (jobs.empty()) idle.notify_all();
+        }
+    }
+};
+
+/*********************************************************************************
+ *                                 GA CLASS
+ ********************************************************************************/
+// DNA requirements : see Individual class;
+//
+// Evaluaor class requirements (see examples folder):
+// constructor(int argc, char** argv)
+// void operator()(const Individual<DNA>& ind)
+// const string name
+//
+// TYPICAL USAGE :
+//
+// GA<DNAType, EvalType> ga;
+// ga.setPopSize(400);
+// return ga.start();
+
+enum class SelectionMethod { paretoTournament, randomObjTournament, nsga2Tournament };
+// format of the population saves: incremental is binary, with each distinct DNA stored
+// once for the whole run
+enum class PopulationFormat { binary, JSON, incremental };
+template <typename DNA> class GA {
+ protected:
+    /*********************************************************************************
+     *                            MAIN GA SETTINGS
+     ********************************************************************************/
+    bool novelty = false;              // enable novelty
+    unsigned int verbosity = 2;        // 0 = silent; 1 = ions stats;
+                                       // 2 = individuals stats; 3 = everything
+    size_t popSize = 500;              // nb of individuals in the population
+    size_t nbElites = 1;               // nb of elites to keep accross generations
+    size_t nbSavedElites = 1;          // nb of elites to save
+    size_t tournamentSize = 3;         // nb of competitors in tournament
+    double minNoveltyForArchive = 1;   // min novelty for being added to the general archive
+    size_t KNN = 15;                   // size of the neighbourhood for novelty
+    bool savePopEnabled = true;        // save the whole population
+    bool saveArchiveEnabled = true;    // save the novelty archive
+    PopulationFormat popFormat = PopulationFormat::binary;  // format of the population saves
+    unsigned int savePopInterval = 1;  // interval between 2 whole population saves
+    unsigned int saveGenInterval = 1;  // interval between 2 elites/pareto saves
+    string folder = "../evos/";        // where to save the results
+    string evaluatorName;              // name of the given evaluator func
+    double crossoverProba = 0.2;       // crossover probability
+    double mutationProba = 0.5;        // mutation probablility
+    bool evaluateAllIndividuals = false;  // force evaluation of every individual
+    bool doSaveParetoFront = false;       // save the pareto front
+    bool doSaveGenStats = true;           // save generations stats to csv file
+    bool doSaveIndStats = false;          // save individuals stats to csv file
+    bool resilientEval = false;           // dynamic, fault tolerant distributed evaluation
+    size_t evalBatchSize = 1;             // nb of individuals per distributed batch
+    double workerTimeout = 60.0;          // silence (s) after which a worker is lost
+    double heartbeatInterval = 1.0;       // min interval (s) between 2 worker heartbeats
+    bool parallelBreeding = false;        // breed offspring with all the OpenMP threads
+    bool fitnessRecycling = false;        // offspring keep their slot's fitness entries
+    SelectionMethod selecMethod = SelectionMethod::paretoTournament;
+    unsigned int checkpointInterval = 0;  // interval between 2 checkpoints (0 = never)
+    bool runLogEnabled = false;           // save in a run log instead of gen folders
+    size_t nbSavedFronts = 0;             // nb of NSGA-II fronts to save
+
+    /********************************************************************************
+     *                                 SETTERS
+     ********************************************************************************/
+ public:
+    using DNA_t = DNA;
+    void enableNovelty() { novelty = true; }
+    void disableNovelty() { novelty = false; }
+    void enablePopulationSave() { savePopEnabled = true; }
+    void disablePopulationSave() { savePopEnabled = false; }
+    void enableArchiveSave() { saveArchiveEnabled = true; }
+    void disableArchiveSave() { saveArchiveEnabled = false; }
+    void setPopulationFormat(PopulationFormat f) { popFormat = f; }
+    // populations, archives, elites and fronts are appended to a run log (see RunLog)
+    // instead of being saved in a folder per generation
+    void enableRunLog() { runLogEnabled = true; }
+    void disableRunLog() { runLogEnabled = false; }
+    void setRunLogSegmentSize(uint64_t bytes) { runLog.setSegmentSize(bytes); }
+    void setVerbosity(unsigned int lvl) { verbosity = lvl <= 3 ? (lvl >= 0 ? lvl : 0) : 3; }
+    void setPopSize(size_t s) { popSize = s; }
+    void setNbElites(size_t n) { nbElites = n; }
+    void setNbSavedElites(size_t n) { nbSavedElites = n; }
+    // With NSGA-II, saves the first n fronts every saveGenInterval generations (see
+    // saveFronts). Default: 0, no front is saved.
+    void setNbSavedFronts(size_t n) { nbSavedFronts = n; }
+    // Replaces the default front files. Called by the I/O thread with the objectives of the
+    // saved individuals and, for each front, its rows in this matrix.
+    using FrontSink = std::function<void(size_t generation, const ObjectiveMatrix &,
+                                         const vector<vector<uint32_t>> &fronts)>;
+    void setFrontSink(FrontSink s) { frontSink = std::move(s); }
+    void setTournamentSize(size_t n) { tournamentSize = n; }
+    void setKNN(size_t n) { KNN = n; }
+    void setPopSaveInterval(unsigned int n) { savePopInterval = n; }
+    void setGenSaveInterval(unsigned int n) { saveGenInterval = n; }
+    // saves a checkpoint in the run's folder every n generations (see saveCheckpoint)
+    void setCheckpointInterval(unsigned int n) { checkpointInterval = n; }
+    void setSaveFolder(string s) { folder = s; }
+    void setCrossoverProba(double p) {
+        crossoverProba = p <= 1.0 ? (p >= 0.0 ? p : 0.0) : 1.0;
+    }
+    void setMutationProba(double p) {
+        mutationProba = p <= 1.0 ? (p >= 0.0 ? p : 0.0) : 1.0;
+    }
+    void setEvaluator(std::function<void(Individual<DNA> &)> e,
+                      std::string ename = "anonymousEvaluator") {
+        evaluator = e;
+        evaluatorName = ename;
+    }
+    void setNewGenerationFunction(std::function<void(void)> f) {
+        newGenerationFunction = f;
+    }
+    void setMinNoveltyForArchive(double m) { minNoveltyForArchive = m; }
+    void setIsBetterMethod(std::function<bool(double, double)> f) { isBetter = f; }
+    void setSelectionMethod(const SelectionMethod &sm) {
+        selecMethod = sm;
+        switch (sm) {
+            case SelectionMethod::paretoTournament:
+                setSelectionPolicy<ParetoTournamentPolicy>();
+                break;
+
+            case SelectionMethod::nsga2Tournament:
+                // NOTE(charly): Should not be needed
+                break;
+
+            case SelectionMethod::randomObjTournament:
+            default:
+                setSelectionPolicy<RandomObjTournamentPolicy>();
+                break;
+        }
+    }
+    // Compile time alternative to setSelectionMethod, which also accepts custom tournament
+    // policies (see TournamentSelector). Not used by NSGA-II.
+    template <typename Policy> void setSelectionPolicy() {
+        selection = [this](const ObjectiveMatrix &obj, size_t n, RandomEngine &rng,
+                           vector<uint32_t> &winners) {
+            tournamentSelector.select<Policy>(obj, tournamentSize, n, isBetter, rng, winners,
+                                              parallelBreeding);
+        };
+    }
+
+    void setEvaluateAllIndividuals(bool m) { evaluateAllIndividuals = m; }
+    void enableResilientEvaluation() { resilientEval = true; }
+    void disableResilientEvaluation() { resilientEval = false; }
+    void setEvalBatchSize(size_t n) { evalBatchSize = n > 0 ? n : 1; }
+    void setWorkerTimeout(double t) { workerTimeout = t; }
+    void setHeartbeatInterval(double t) { heartbeatInterval = t; }
+    // DNA's mutate and crossover are then called concurrently: they must be thread safe
+    // and must not modify the parents
+    void enableParallelBreeding() { parallelBreeding = true; }
+    void disableParallelBreeding() { parallelBreeding = false; }
+    // Offspring keep the fitness entries of the individual whose storage they reuse, and the
+    // evaluator overwrites their values instead of allocating new entries. Entries are
+    // stamped before the evaluation (see unsetFitnessStamp) and the ones still stamped
+    // afterwards are removed, so the evaluator must not read the fitnesses of the individual
+    // it evaluates. Any value the evaluator sets is kept, NaN included.
+    void enableFitnessRecycling() { fitnessRecycling = true; }
+    void disableFitnessRecycling() { fitnessRecycling = false; }
+    void setSeed(uint64_t s) { randomStreams.setSeed(s); }
+    uint64_t getSeed() const { return randomStreams.getSeed(); }
+    size_t getCurrentGeneration() const { return currentGeneration; }
+    const RingBuffer<GenStats> &getGenStats() const { return genStats; }
+    RandomStreams &getRandomStreams() { return randomStreams; }
+    void setSaveParetoFront(bool m) { doSaveParetoFront = m; }
+    void setSaveGenStats(bool m) { doSaveGenStats = m; }
+    // nb of generations whose stats are kept in memory (genStats)
+    void setGenStatsHistory(size_t n) { genStats.setCapacity(n); }
+    // nb of generations between 2 flushes of gen_stats.csv
+    void setGenStatsFlushInterval(size_t n) { genStatsWriter.setFlushInterval(n); }
+    // Saves (populations, archive, elites, fronts & stats) are copied, then serialised and
+    // written by a background thread while the run goes on. DNA's serialize() must then not
+    // rely on shared state. At most n saves can wait for the disk.
+    void enableAsyncSaving() { asyncWriter.setEnabled(true); }
+    void disableAsyncSaving() { asyncWriter.setEnabled(false); }
+    void setSaveQueueSize(size_t n) { asyncWriter.setMaxPending(n); }
+    // blocks until all the saves are on disk, and rethrows the failure of one, if any
+    void waitForSaves() { asyncWriter.drain(); }
+    void setSaveIndStats(bool m) { doSaveIndStats = m; }
+    // deflates the blocks of ind_stats.bin (needs ZLIB)
+    void setIndStatsCompression(bool c) { indStatsWriter.setCompression(c); }
+    vector<Individual<DNA>> population;
+    vector<Individual<DNA>> lastGen;
+
+    ////////////////////////////////////////////////////////////////////////////////////
+
+ protected:
+    vector<Individual<DNA>>
+        archive;  // when novelty is enabled, we store the novel individuals there (master)
+    vector<double> archiveShard;  // flattened footprints of this rank's archive entries
+    size_t archiveCount = 0;      // size of the whole archive, known by every rank
+    // retired individuals, whose storage is reused for the next offspring (recycledSlot)
+    vector<Individual<DNA>> spareIndividuals;
+    NSGA2Sorter nsga2Sorter;  // scratch data of the generation's sorts
+    size_t currentGeneration = 0;
+    bool customInit = false;
+    // openmp/mpi stuff
+    int procId = 0;
+    int nbProcs = 1;
+    // nb of ranks taking part in the collective steps (novelty, NSGA-II sort, trace). With
+    // resilientEval, workers can be lost at any time and only talk to the master point to
+    // point: these steps are then done by the master alone.
+    int nbCollectiveRanks() const { return resilientEval ? 1 : nbProcs; }
+#if defined(CLUSTER) && defined(OMP)
+    // hybrid topology: ranks sharing memory are grouped per node, and only the first
+    // rank of each node (its leader) exchanges individuals with the master
+    MPI_Comm nodeComm = MPI_COMM_NULL;    // ranks of this physical node
+    MPI_Comm leaderComm = MPI_COMM_NULL;  // node leaders only (master is leader 0)
+    int nodeRank = 0;
+    int nodeSize = 1;
+    int nbNodes = 1;
+    vector<int> nodeThreads;  // nb of evaluation threads of each node (master only)
+#endif
+    // distributed evaluation (see "RESILIENT EVALUATION" and "SOCKET WORKERS")
+    EvalScheduler scheduler;
+    uint64_t evalRound = 0;  // nb of calls to evaluatePopulation, identical on every rank
+    // true on a worker while it evaluates a batch (read by every evaluation thread)
+    std::atomic<bool> sendHeartbeats{false};
+    EvalScheduler::clock::time_point lastHeartbeat;  // only used by the main thread
+#ifdef CLUSTER
+    enum MPI_Tag {
+        TAG_REQUEST = 1,
+        TAG_BATCH,
+        TAG_RESULTS,
+        TAG_HEARTBEAT,
+        TAG_ROUND_OVER,
+        TAG_TRACE
+    };
+    MPI_Comm heartbeatComm = MPI_COMM_NULL;
+    struct MPI_PendingSend {
+        MPI_Request request;
+        int dest;
+        string msg;
+    };
+    std::list<MPI_PendingSend> pendingSends;  // master's Isends in flight
+    bool workersRegistered = false;  // the master's scheduler knows every rank
+#endif
+#ifdef SOCKET_WORKERS
+    Socket workersListener;               // master side, listening for workers
+    string workersAddress;
+    std::map<int, Socket> workerSockets;  // connected workers, by scheduler id
+    int nextWorkerId = 1;
+    Socket *masterSocket = nullptr;  // worker side, connection to the master
+#endif
+    int argc = 1;
+    char **argv = nullptr;
+
+    RingBuffer<GenStats> genStats;  // stats of the last generations, indexed by generation
+    GenStatsWriter genStatsWriter;  // only used by saving jobs
+    IndStatsWriter indStatsWriter;  // only used by saving jobs
+    DNAStore dnaStore;              // only used by saving jobs (incremental populations)
+    RunLogWriter runLog;            // only used by saving jobs
+    // Saves are snapshots handed to this writer. Declared after everything its jobs use, so
+    // that it's destroyed (and drained) first.
+    AsyncWriter asyncWriter;
+    bool resumed = false;  // the run was resumed from a checkpoint: append to its files
+    size_t resumedGeneration = 0;  // ... whose records from this generation on are dropped
+
+    std::random_device rd;
+    RandomStreams randomStreams{(static_cast<uint64_t>(rd()) << 32) ^ rd()};
+
+    std::function<void(Individual<DNA> &)> evaluator;
+    // picks the winners (population slots) of n tournaments at once
+    std::function<void(const ObjectiveMatrix &, size_t, RandomEngine &, vector<uint32_t> &)>
+        selection;
+    std::function<void(void)> newGenerationFunction = []() {};
+    FrontSink frontSink;  // see setFrontSink
+    std::function<bool(double, double)> isBetter = [](double a, double b) { return a > b; };
 
  public:
     /*********************************************************************************
@@ -339,9 +3058,13 @@ template <typename DNA> class GA {
     GA(int ac, char **av) : argc(ac), argv(av) {
         setSelectionMethod(selecMethod);
 #ifdef CLUSTER
-        MPI_Init(&argc, &argv);
+        int threadSupport;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
         MPI_Comm_size(MPI_COMM_WORLD, &nbProcs);
         MPI_Comm_rank(MPI_COMM_WORLD, &procId);
+#ifdef OMP
+        initNodeTopology();
+#endif
         if (procId == 0) {
             if (verbosity >= 3) {
                 std::cout << "   -------------------" << endl;
@@ -351,6 +3074,10 @@ template <typename DNA> class GA {
                 std::cout << "Initialising population in master process" << endl;
             }
         }
+#endif
+#ifdef TRACING
+        Tracer::get().setRank(procId);
+        Tracer::get().setThreadName("main");
 #endif
     }
 
@@ -360,6 +3087,7 @@ template <typename DNA> class GA {
     void setPopulation(const vector<Individual<DNA>> &p) {
         if (procId == 0) {
             population = p;
+            elitesCached = false;
             if (population.size() != popSize)
                 throw std::invalid_argument("Population doesn't match the popSize param");
             popSize = population.size();
@@ -373,6 +3101,7 @@ template <typename DNA> class GA {
                 population.push_back(Individual<DNA>(f()));
                 population[population.size() - 1].evaluated = false;
             }
+            elitesCached = false;
         }
     }
 
@@ -393,14 +3122,15 @@ template <typename DNA> class GA {
         else
         {
             for (int nbg = 0; nbg < nbGeneration; ++nbg) {
-
+                GAGA_TRACE_SPAN("generation");
                 auto tg0 = high_resolution_clock::now();
                 evaluatePopulation(population);
+                if (procId == 0 && population.size() != popSize)
+                    throw std::invalid_argument("Population doesn't match the popSize param");
+                if (novelty) updateNovelty();  // collective (see nbCollectiveRanks)
+                elitesCached = false;  // fitnesses are final: saves and breeding share elites
 
                 if (procId == 0) {
-                    if (population.size() != popSize)
-                        throw std::invalid_argument("Population doesn't match the popSize param");
-                    if (novelty) updateNovelty();
                     auto tg1 = high_resolution_clock::now();
                     double totalTime = std::chrono::duration<double>(tg1 - tg0).count();
                     updateStats(totalTime);
@@ -428,126 +3158,141 @@ template <typename DNA> class GA {
                     }
                 }
                 ++currentGeneration;
+                autoCheckpoint();
             }
         }
     }
 
     void nsga2Step(int nbGenerations)
     {
-        // Evaluate parent population only the first time
+        // Evaluate and rank parent population only the first time
         if (currentGeneration == 0)
-        {
-            evaluatePopulation(population);
-        }
-
-        std::uniform_real_distribution<> d(0.0, 1.0);
-        auto rng = std::bind(d, globalRand);
-
-        for (int nbg = 0; nbg < nbGenerations; ++nbg)
-        {
-            auto tg0 = high_resolution_clock::now();
-            // Generate new pop Qt
-            std::vector<size_t> a(popSize), b(popSize);
-
-            for (size_t i = 0; i < popSize; ++i) a[i] = b[i] = i;
-            std::shuffle(a.begin(), a.end(), globalRand);
-            std::shuffle(b.begin(), b.end(), globalRand);
-
-            std::vector<Individual<DNA>> child_pop;
-            std::vector<Individual<DNA>> mixed_pop;
-
-            // FIXME(charly): Validate the new population creation
-            for (size_t i = 0; i < popSize; i += 4)
-            {
-                Individual<DNA>* p00 = nsga2Tournament(&population[a[i+0]], &population[a[i+1]]);
-                Individual<DNA>* p01 = nsga2Tournament(&population[a[i+2]], &population[a[i+3]]);
-
-                if (rng() < crossoverProba)
-                {
-                    Individual<DNA> c0, c1;
-                    p00->dna.crossover(p01->dna, c0.dna, c1.dna);
-
-                    c0.evaluated = c1.evaluated = false;
-
-                    child_pop.push_back(c0);
-                    child_pop.push_back(c1);
-                }
-                else
-                {
-                    child_pop.push_back(*p00);
-                    child_pop.push_back(*p01);
-                }
-
-                Individual<DNA>* p10 = nsga2Tournament(&population[b[i+0]], &population[b[i+1]]);
-                Individual<DNA>* p11 = nsga2Tournament(&population[b[i+2]], &population[b[i+3]]);
-
-                if (rng() < crossoverProba)
-                {
-                    Individual<DNA> c0, c1;
-                    p10->dna.crossover(p11->dna, c0.dna, c1.dna);
-
-                    c0.evaluated = c1.evaluated = false;
-
-                    child_pop.push_back(c0);
-                    child_pop.push_back(c1);
-                }
-                else
-                {
-                    child_pop.push_back(*p10);
-                    child_pop.push_back(*p11);
-                }
-            }
+        {
+            evaluatePopulation(population);
+            nsga2SortAllRanks(population, paretoRanking);
+        }
 
-            assert(child_pop.size() == population.size());
+        for (int nbg = 0; nbg < nbGenerations; ++nbg)
+        {
+            GAGA_TRACE_SPAN("generation");
+            auto tg0 = high_resolution_clock::now();
+            // Only the master breeds and selects; the other ranks take part in the
+            // evaluation and in the sort
+            std::vector<Individual<DNA>> child_pop;
+            std::vector<Individual<DNA>> mixed_pop;
 
-            // Mutate pop Qt
-            for (auto& indiv : child_pop)
+            if (procId == 0)
             {
-                if (rng() < mutationProba)
+                GAGA_TRACE_SPAN("breeding");
+                // Generate new pop Qt. Each pair of children has its own random stream, and
+                // the shuffles use the generation's stream
+                RandomEngine shuffleRng = breedingStream(std::numeric_limits<uint64_t>::max());
+                std::vector<size_t> a(popSize), b(popSize);
+
+                for (size_t i = 0; i < popSize; ++i) a[i] = b[i] = i;
+                std::shuffle(a.begin(), a.end(), shuffleRng);
+                std::shuffle(b.begin(), b.end(), shuffleRng);
+
+                // children come in pairs: with an odd popSize, the last one is dropped
+                const size_t nbChildren = popSize + popSize % 2;
+                child_pop.reserve(nbChildren);
+                while (child_pop.size() < nbChildren) recycledSlot(child_pop);
+
+                // FIXME(charly): Validate the new population creation
+                // Children 4k and 4k+1 come from tournaments on a[4k..4k+3], children 4k+2
+                // and 4k+3 from tournaments on b[4k..4k+3] (indices wrap around when popSize
+                // isn't a multiple of 4)
+#ifdef OMP
+#pragma omp parallel for schedule(dynamic, 1) if (parallelBreeding)
+#endif
+                for (size_t s = 0; s < popSize; s += 2)
                 {
-                    indiv.dna.mutate();
-                    indiv.evaluated = false;
+                    const std::vector<size_t> &perm = (s % 4 == 0) ? a : b;
+                    const size_t i = s - s % 4;
+                    nsga2BreedPair(perm[i], perm[(i + 1) % popSize], perm[(i + 2) % popSize],
+                                   perm[(i + 3) % popSize], child_pop[s], child_pop[s + 1], s);
+                }
+                if (child_pop.size() > popSize) {
+                    spareIndividuals.push_back(std::move(child_pop.back()));
+                    child_pop.pop_back();
                 }
             }
 
             // Evaluate Qt
             evaluatePopulation(child_pop);
 
-            // Merge Pt and Qt -> Rt
-            mixed_pop.clear();
-            mixed_pop.insert(mixed_pop.end(), population.begin(), population.end());
-            mixed_pop.insert(mixed_pop.end(), child_pop.begin(), child_pop.end());
+            // Merge Pt and Qt -> Rt (Pt is [0, popSize), Qt the rest)
+            const size_t nbParents = population.size();
+            if (procId == 0)
+            {
+                mixed_pop.reserve(nbParents + child_pop.size());
+                std::move(population.begin(), population.end(), std::back_inserter(mixed_pop));
+                std::move(child_pop.begin(), child_pop.end(), std::back_inserter(mixed_pop));
+            }
 
             // Sort Rt (nsga2)
-            nsga2SortPopulation(mixed_pop);
-
-            // Generate P(t+1)
-            std::vector<Individual<DNA>> new_population;
+            nsga2SortAllRanks(mixed_pop, mixedRanking);
 
-            int front = 0;
-            while (new_population.size() + paretoFronts[front].size() < population.size())
+            if (procId == 0)
             {
-                for (auto indiv : paretoFronts[front])
+                if (nbSavedFronts > 0 && currentGeneration % saveGenInterval == 0)
+                    saveFronts(mixed_pop, mixedRanking);
+                GAGA_TRACE_SPAN("survivors");
+
+                // Generate P(t+1), as indices in Rt
+                std::vector<size_t> survivors;
+                survivors.reserve(nbParents);
+
+                size_t front = 0;
+                while (survivors.size() + mixedRanking.fronts[front].size() < nbParents)
                 {
-                    new_population.push_back(*indiv);
+                    for (auto indiv : mixedRanking.fronts[front])
+                    {
+                        survivors.push_back(indiv);
+                    }
+
+                    ++front;
                 }
 
-                ++front;
-            }
+                // Take the least crowded individuals of the last front (ties by slot)
+                if (survivors.size() < nbParents)
+                {
+                    std::vector<uint32_t> last = mixedRanking.fronts[front];
+                    const size_t nbKept = nbParents - survivors.size();
+                    const auto &crowding = mixedRanking.crowding;
+                    std::nth_element(last.begin(), last.begin() + nbKept, last.end(),
+                                     [&](uint32_t a, uint32_t b) {
+                                         if (crowding[a] != crowding[b])
+                                             return crowding[a] > crowding[b];
+                                         return a < b;
+                                     });
+                    survivors.insert(survivors.end(), last.begin(), last.begin() + nbKept);
+                }
 
-            // Take best individuals of the last front
-            int indiv_idx = 0;
-            while (new_population.size() < population.size())
-            {
-                new_population.push_back(*paretoFronts[front][indiv_idx]);
+                // Children are moved in, parents are copied (into the retiring generation's
+                // storage) since Pt is kept as lastGen
+                retire(lastGen);
+                lastGen.reserve(nbParents);
+                std::vector<bool> survived(mixed_pop.size(), false);
+                for (auto i : survivors)
+                {
+                    survived[i] = true;
+                    if (i < nbParents) recycledSlot(lastGen) = mixed_pop[i];
+                    else lastGen.push_back(std::move(mixed_pop[i]));
+                }
+                population.assign(std::make_move_iterator(mixed_pop.begin()),
+                                  std::make_move_iterator(mixed_pop.begin() + nbParents));
+                population.swap(lastGen);
+                mixedRanking.subset(survivors, paretoRanking);
+
+                // Dead children are recycled as well
+                for (size_t i = nbParents; i < mixed_pop.size(); ++i)
+                    if (!survived[i]) spareIndividuals.push_back(std::move(mixed_pop[i]));
             }
 
-            lastGen = population;
-            population = new_population;
-
+            if (novelty) updateNovelty();  // collective (see nbCollectiveRanks)
             if (procId == 0)
             {
-                if (novelty) updateNovelty();
                 auto tg1 = high_resolution_clock::now();
                 double totalTime = std::chrono::duration<double>(tg1 - tg0).count();
                 updateStats(totalTime);
@@ -555,51 +3300,251 @@ template <typename DNA> class GA {
             }
 
             ++currentGeneration;
+            autoCheckpoint();
         }
     }
 
     void finish() {
+        asyncWriter.stop();
+#ifdef TRACING
+        writeTrace();
+#endif
+        genStatsWriter.close();
+        indStatsWriter.close();
+        dnaStore.close();
+        runLog.close();
+#ifdef SOCKET_WORKERS
+        for (auto &ws : workerSockets) ws.second.send(Socket::BYE, "");
+        workerSockets.clear();
+        if (workersListener.valid() && workersAddress.compare(0, 7, "unix://") == 0)
+            ::unlink(workersAddress.substr(7).c_str());
+        workersListener.close();
+#endif
 #ifdef CLUSTER
+#ifdef OMP
+        // with resilientEval, these communicators might have lost ranks, and freeing them
+        // is a collective: they're left to MPI_Finalize
+        if (!resilientEval) {
+            if (leaderComm != MPI_COMM_NULL) MPI_Comm_free(&leaderComm);
+            MPI_Comm_free(&nodeComm);
+        }
+#endif
         MPI_Finalize();
 #endif
+        asyncWriter.rethrow();  // a save that failed on the I/O thread
+    }
+
+    // Writes the spans recorded so far (see TRACING) in trace.json, in the run's folder.
+    // With MPI, the spans of every rank are gathered by the master: every rank must call it.
+    // With resilientEval, ranks send them point to point instead, and the master waits at
+    // most workerTimeout seconds for them, so that a lost rank doesn't block the shutdown.
+    void writeTrace() {
+        vector<string> events{Tracer::get().events()};
+        Tracer::get().clear();
+#ifdef CLUSTER
+        if (nbProcs > 1 && nbCollectiveRanks() == 1) {
+            if (procId != 0) {
+                MPI_Send(&events[0][0], static_cast<int>(events[0].size()), MPI_BYTE, 0,
+                         TAG_TRACE, MPI_COMM_WORLD);
+                return;
+            }
+            using clock = EvalScheduler::clock;
+            events.resize(static_cast<size_t>(nbProcs));
+            auto t0 = clock::now();
+            int nbReceived = 1;
+            while (nbReceived < nbProcs &&
+                   std::chrono::duration<double>(clock::now() - t0).count() < workerTimeout) {
+                int received = 0;
+                MPI_Status status;
+                if (MPI_Iprobe(MPI_ANY_SOURCE, TAG_TRACE, MPI_COMM_WORLD, &received,
+                               &status) != MPI_SUCCESS ||
+                    !received) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+                if (MPI_tryRecvString(status, MPI_COMM_WORLD,
+                                      events[static_cast<size_t>(status.MPI_SOURCE)]))
+                    ++nbReceived;
+            }
+            if (nbReceived < nbProcs && verbosity >= 1)
+                cerr << YELLOW << "The trace misses " << nbProcs - nbReceived << " lost rank(s)"
+                     << NORMAL << endl;
+        } else if (nbProcs > 1) {
+            int size = static_cast<int>(events[0].size());
+            vector<int> sizes(static_cast<size_t>(nbProcs)), displs(sizes.size());
+            MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+            string all;
+            if (procId == 0) {
+                for (size_t r = 1; r < sizes.size(); ++r) displs[r] = displs[r - 1] + sizes[r - 1];
+                all.resize(static_cast<size_t>(displs.back() + sizes.back()));
+            }
+            MPI_Gatherv(&events[0][0], size, MPI_CHAR, &all[0], sizes.data(), displs.data(),
+                        MPI_CHAR, 0, MPI_COMM_WORLD);
+            if (procId != 0) return;
+            events.clear();
+            for (size_t r = 0; r < sizes.size(); ++r)
+                events.push_back(all.substr(static_cast<size_t>(displs[r]),
+                                            static_cast<size_t>(sizes[r])));
+        }
+#endif
+        if (procId != 0) return;
+        std::ofstream file(folder + "/trace.json");
+        Tracer::writeDocument(file, events);
+        if (!file) cerr << "Cannot write " << folder << "/trace.json" << endl;
     }
 
     void evaluatePopulation(std::vector<Individual<DNA>>& pop)
     {
+        GAGA_TRACE_SPAN("evaluation");
         newGenerationFunction();
+        ++evalRound;
 
+#ifdef SOCKET_WORKERS
+        if (workersListener.valid()) {
+            socketEvaluation(pop);
+            return;
+        }
+#endif
 #ifdef CLUSTER
+        if (resilientEval && nbProcs > 1) {
+            MPI_resilientEvaluation(pop);
+            return;
+        }
         MPI_distributePopulation(pop);
 #endif
+#if defined(CLUSTER) && defined(OMP)
+        MPI_evaluateOnNode(pop);
+#else
 #ifdef OMP
 #pragma omp parallel for schedule(dynamic, 1)
 #endif
-        for (size_t i = 0; i < pop.size(); ++i) {
-            if (evaluateAllIndividuals || !pop[i].evaluated) {
-                auto t0 = high_resolution_clock::now();
-                pop[i].dna.reset();
-                evaluator(pop[i]);
-                auto t1 = high_resolution_clock::now();
-                pop[i].evaluated = true;
-                double indTime = std::chrono::duration<double>(t1 - t0).count();
-                pop[i].evalTime = indTime;
-                pop[i].wasAlreadyEvaluated = false;
-            } else {
-                pop[i].evalTime = 0.0;
-                pop[i].wasAlreadyEvaluated = true;
-            }
-            if (verbosity >= 2) printIndividualStats(pop[i]);
-        }
+        for (size_t i = 0; i < pop.size(); ++i) evaluateIndividual(pop[i]);
+#endif
 #ifdef CLUSTER
         MPI_receivePopulation(pop);
 #endif
 
     }
 
+    void evaluateIndividual(Individual<DNA> &ind) {
+        if (evaluateAllIndividuals || !ind.evaluated) {
+            auto t0 = high_resolution_clock::now();
+            ind.dna.reset();
+            const uint64_t stamp = unsetFitnessStamp();
+            if (fitnessRecycling)
+                for (auto &f : ind.fitnesses) std::memcpy(&f.second, &stamp, sizeof(double));
+            evaluator(ind);
+            auto t1 = high_resolution_clock::now();
+            if (fitnessRecycling) {  // removes the entries that the evaluator didn't set
+                for (auto it = ind.fitnesses.begin(); it != ind.fitnesses.end();) {
+                    uint64_t bits;
+                    std::memcpy(&bits, &it->second, sizeof(bits));
+                    if (bits == stamp)
+                        it = ind.fitnesses.erase(it);
+                    else
+                        ++it;
+                }
+            }
+            ind.evaluated = true;
+            double indTime = std::chrono::duration<double>(t1 - t0).count();
+            ind.evalTime = indTime;
+            ind.wasAlreadyEvaluated = false;
+        } else {
+            ind.evalTime = 0.0;
+            ind.wasAlreadyEvaluated = true;
+        }
+        if (verbosity >= 2) printIndividualStats(ind);
+        heartbeat();
+    }
+
+    // Bits of the value recycled fitness entries hold until the evaluator sets them: a
+    // signaling NaN, which no arithmetic produces, whose payload is the evaluation round.
+    // Entries are told apart by these exact bits, not by being NaN.
+    uint64_t unsetFitnessStamp() const {
+        return 0x7ff4000000000000ULL | (evalRound & 0x0003ffffffffffffULL);
+    }
+
+    // called after each evaluation: a busy worker tells its master it's still alive
+    void heartbeat() {
+#ifdef OMP
+        if (omp_get_thread_num() != 0) return;  // only the main thread communicates
+#endif
+        if (!sendHeartbeats) return;
+        auto now = EvalScheduler::clock::now();
+        if (std::chrono::duration<double>(now - lastHeartbeat).count() < heartbeatInterval)
+            return;
+        lastHeartbeat = now;
+#ifdef SOCKET_WORKERS
+        if (masterSocket) {
+            masterSocket->send(Socket::HEARTBEAT, "");
+            return;
+        }
+#endif
+#ifdef CLUSTER
+        // a failure isn't reported from here (maybe in a parallel region): the worker
+        // finds out that the master is gone when it sends its results
+        if (MPI_Send(&evalRound, 1, MPI_UINT64_T, 0, TAG_HEARTBEAT, heartbeatComm) != MPI_SUCCESS)
+            sendHeartbeats = false;
+#endif
+    }
+
     // MPI specifics
 #ifdef CLUSTER
+    static void MPI_sendBatch(const vector<Individual<DNA>> &batch, int dest, MPI_Comm comm) {
+        std::ostringstream out;
+        Individual<DNA>::popToJSON(out, batch);
+        string batchStr = out.str();
+        MPI_Send(batchStr.data(), static_cast<int>(batchStr.size()), MPI_BYTE, dest, 0, comm);
+    }
+
+    static vector<Individual<DNA>> MPI_recvBatch(int source, MPI_Comm comm) {
+        MPI_Status status;
+        MPI_Probe(source, 0, comm, &status);  // we want to know its size
+        // and we dejsonize !
+        std::istringstream in(MPI_recvString(status, comm));
+        return Individual<DNA>::loadPopFromJSON(in);
+    }
+
+    // receives the message matched by a probe
+    static string MPI_recvString(const MPI_Status &status, MPI_Comm comm) {
+        string str;
+        if (!MPI_tryRecvString(status, comm, str))
+            throw std::runtime_error("Cannot receive from rank " +
+                                     std::to_string(status.MPI_SOURCE));
+        return str;
+    }
+
+    // same, but returns false if the receive failed (with MPI_ERRORS_RETURN)
+    static bool MPI_tryRecvString(const MPI_Status &status, MPI_Comm comm, string &str) {
+        int strLength;
+        if (MPI_Get_count(&status, MPI_BYTE, &strLength) != MPI_SUCCESS || strLength < 0)
+            return false;
+        str.assign(static_cast<size_t>(strLength), '\0');
+        return MPI_Recv(&str[0], strLength, MPI_BYTE, status.MPI_SOURCE, status.MPI_TAG, comm,
+                        MPI_STATUS_IGNORE) == MPI_SUCCESS;
+    }
+
     void MPI_distributePopulation(std::vector<Individual<DNA>>& pop) {
+        GAGA_TRACE_SPAN("MPI distribution");
+#ifdef OMP
+        // hybrid: only node leaders get a batch, other ranks are fed by their leader
+        if (nodeRank != 0) return;
+#endif
         if (procId == 0) {
+#ifdef OMP
+            // each node gets a share proportional to its nb of threads
+            auto shares = nodeShares(pop.size());
+            size_t offset = shares[0];
+            for (int node = 1; node < nbNodes; ++node) {
+                auto first = pop.begin() + static_cast<std::ptrdiff_t>(offset);
+                auto last = first + static_cast<std::ptrdiff_t>(shares[node]);
+                vector<Individual<DNA>> batch(std::make_move_iterator(first),
+                                              std::make_move_iterator(last));
+                MPI_sendBatch(batch, node, leaderComm);
+                offset += shares[node];
+            }
+            pop.erase(pop.begin() + static_cast<std::ptrdiff_t>(shares[0]), pop.end());
+#else
             // if we're in the master process, we send b(i)atches to the others.
             // master will have the remaining
             size_t batchSize = pop.size() / nbProcs;
@@ -609,22 +3554,16 @@ template <typename DNA> class GA {
                     batch.push_back(pop.back());
                     pop.pop_back();
                 }
-                string batchStr = Individual<DNA>::popToJSON(batch).dump();
-                std::vector<char> tmp(batchStr.begin(), batchStr.end());
-                tmp.push_back('\0');
-                MPI_Send(tmp.data(), tmp.size(), MPI_BYTE, dest, 0, MPI_COMM_WORLD);
+                MPI_sendBatch(batch, static_cast<int>(dest), MPI_COMM_WORLD);
             }
+#endif
         } else {
             // we're in a slave process, we welcome our local population !
-            int strLength;
-            MPI_Status status;
-            MPI_Probe(0, 0, MPI_COMM_WORLD, &status);  // we want to know its size
-            MPI_Get_count(&status, MPI_CHAR, &strLength);
-            char *popChar = new char[strLength + 1];
-            MPI_Recv(popChar, strLength, MPI_BYTE, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            // and we dejsonize !
-            auto o = json::parse(popChar);
-            pop = Individual<DNA>::loadPopFromJSON(o);  // welcome bros!
+#ifdef OMP
+            pop = MPI_recvBatch(0, leaderComm);
+#else
+            pop = MPI_recvBatch(0, MPI_COMM_WORLD);
+#endif
             if (verbosity >= 3) {
                 std::ostringstream buf;
                 buf << endl
@@ -636,26 +3575,23 @@ template <typename DNA> class GA {
     }
 
     void MPI_receivePopulation(std::vector<Individual<DNA>>& pop) {
+        GAGA_TRACE_SPAN("MPI reception");
+#ifdef OMP
+        if (nodeRank != 0) return;  // node results are gathered by the node leader
+        MPI_Comm comm = leaderComm;
+        int nbSources = nbNodes;
+#else
+        MPI_Comm comm = MPI_COMM_WORLD;
+        int nbSources = nbProcs;
+#endif
         if (procId != 0) {  // if slave process we send our population to our mighty leader
-            string batchStr = Individual<DNA>::popToJSON(pop).dump();
-            std::vector<char> tmp(batchStr.begin(), batchStr.end());
-            tmp.push_back('\0');
-            MPI_Send(tmp.data(), tmp.size(), MPI_BYTE, 0, 0, MPI_COMM_WORLD);
+            MPI_sendBatch(pop, 0, comm);
         } else {
             // master process receives all other batches
-            for (size_t source = 1; source < (size_t)nbProcs; ++source) {
-                int strLength;
-                MPI_Status status;
-                MPI_Probe(source, 0, MPI_COMM_WORLD, &status);  // determining batch size
-                MPI_Get_count(&status, MPI_CHAR, &strLength);
-                char *popChar = new char[strLength + 1];
-                MPI_Recv(popChar, strLength + 1, MPI_BYTE, source, 0, MPI_COMM_WORLD,
-                        MPI_STATUS_IGNORE);
-                // and we dejsonize!
-                auto o = json::parse(popChar);
-                vector<Individual<DNA>> batch = Individual<DNA>::loadPopFromJSON(o);
-                pop.insert(pop.end(), batch.begin(), batch.end());
-                delete popChar;
+            for (int source = 1; source < nbSources; ++source) {
+                vector<Individual<DNA>> batch = MPI_recvBatch(source, comm);
+                pop.insert(pop.end(), std::make_move_iterator(batch.begin()),
+                           std::make_move_iterator(batch.end()));
                 if (verbosity >= 3) {
                     cout << endl
                         << "Proc " << procId << " : reception of " << batch.size()
@@ -664,258 +3600,820 @@ template <typename DNA> class GA {
             }
         }
     }
-#endif
+
+#ifdef OMP
     /*********************************************************************************
-     *                            NEXT POP GETTING READY
+     *                            HYBRID EVALUATION
      ********************************************************************************/
-    // Là où qu'on fait les bébés.
-    void prepareNextPop() {
-        assert(tournamentSize > 0);
-        assert(population.size() == popSize);
-        vector<Individual<DNA>> nextGen;
-        nextGen.reserve(popSize);
-        std::uniform_real_distribution<double> d(0.0, 1.0);
-
-        // Save this generation
-        lastGen = population;
-
-        // elitism
-        auto elites = getElites(nbElites);
-        for (auto &e : elites)
-            for (auto &i : e.second) nextGen.push_back(i);
-
-        if (verbosity >= 3) cerr << "preparing rest of the population" << endl;
-        while (nextGen.size() < popSize) {
-            // selection + crossover
-            Individual<DNA> *p0 = selection();
-            Individual<DNA> offspring;
-            if (d(globalRand) < crossoverProba) {
-                if (verbosity >= 3) cerr << "crossover" << endl;
-                Individual<DNA> *p1 = selection();
-                offspring = Individual<DNA>(p0->dna.crossover(p1->dna));
-                offspring.evaluated = false;
-                if (verbosity >= 3) cerr << "crossover ok" << endl;
-            } else {
-                if (verbosity >= 3) cerr << "no crossover" << endl;
-                offspring = *p0;
-            }
-            // mutation
-            if (d(globalRand) < mutationProba) {
-                if (verbosity >= 3) cerr << "mutation" << endl;
-                offspring.dna.mutate();
-                offspring.evaluated = false;
-            }
-            if (verbosity >= 3) cerr << "pushing" << endl;
-            nextGen.push_back(offspring);
+    // With both CLUSTER and OMP, ranks sharing a physical node are grouped together
+    // (MPI_Comm_split_type). The master only talks to one leader per node; the leader then
+    // hands its batch to the other ranks of its node through an MPI shared memory window,
+    // and every OpenMP thread of every rank of the node pulls individuals from this window
+    // through a shared atomic counter, so the whole node behaves as one thread pool.
+    // Unless OMP_NUM_THREADS is set, each rank runs nbCores / nbRanksOnNode threads so
+    // that launching several ranks per node doesn't oversubscribe it.
+    void initNodeTopology() {
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, procId, MPI_INFO_NULL,
+                            &nodeComm);
+        MPI_Comm_rank(nodeComm, &nodeRank);
+        MPI_Comm_size(nodeComm, &nodeSize);
+        MPI_Comm_split(MPI_COMM_WORLD, nodeRank == 0 ? 0 : MPI_UNDEFINED, procId,
+                       &leaderComm);
+        if (!std::getenv("OMP_NUM_THREADS"))
+            omp_set_num_threads(std::max(1, omp_get_num_procs() / nodeSize));
+        int threads = omp_get_max_threads();
+        int threadsOnNode = 0;
+        MPI_Reduce(&threads, &threadsOnNode, 1, MPI_INT, MPI_SUM, 0, nodeComm);
+        if (nodeRank == 0) {
+            MPI_Comm_size(leaderComm, &nbNodes);
+            if (procId == 0) nodeThreads.resize(static_cast<size_t>(nbNodes));
+            MPI_Gather(&threadsOnNode, 1, MPI_INT, nodeThreads.data(), 1, MPI_INT, 0,
+                       leaderComm);
+        }
+        if (procId == 0 && verbosity >= 3) {
+            cout << "Hybrid evaluation on " << nbNodes << " node(s), threads per node:";
+            for (auto &t : nodeThreads) cout << " " << t;
+            cout << endl;
         }
-        if (verbosity >= 3) cerr << "done" << endl;
-        assert(nextGen.size() == popSize);
-        population.clear();
-        population = nextGen;
-        if (verbosity >= 3) cerr << "done completely" << endl;
     }
 
-    int nsga2ParetoDominates(Individual<DNA>* a, Individual<DNA>* b)
-    {
-        int a_dominates = 0;
-        int b_dominates = 0;
+    // splits n individuals between nodes, proportionally to their nb of threads
+    vector<size_t> nodeShares(size_t n) const {
+        size_t totalThreads = 0;
+        for (auto &t : nodeThreads) totalThreads += static_cast<size_t>(t);
+        vector<size_t> shares(nodeThreads.size());
+        size_t given = 0;
+        for (size_t i = 0; i < shares.size(); ++i) {
+            shares[i] = n * static_cast<size_t>(nodeThreads[i]) / totalThreads;
+            given += shares[i];
+        }
+        for (size_t i = 0; given < n; ++i, ++given) ++shares[i % shares.size()];
+        return shares;
+    }
 
-        for (auto o : a->fitnesses)
+    // Evaluates the batch held by the node leader with all the threads of the node.
+    // Input window (leader's segment): [next index][n + 1 offsets][serialized individuals]
+    // Output windows (one segment per rank): [nb results]([index][size][individual])*
+    // Returns false (on non leaders) when the leader signals that no batch is coming.
+    bool MPI_evaluateOnNode(std::vector<Individual<DNA>> &pop) {
+        GAGA_TRACE_SPAN("node evaluation");
+        if (nodeSize == 1) {
+#pragma omp parallel for schedule(dynamic, 1)
+            for (size_t i = 0; i < pop.size(); ++i) evaluateIndividual(pop[i]);
+            return true;
+        }
+        vector<string> serialized;
+        vector<uint64_t> offsets(1, 0);
+        if (nodeRank == 0) {
+            serialized.reserve(pop.size());
+            for (auto &ind : pop) {
+                serialized.push_back(ind.toJSON().dump());
+                offsets.push_back(offsets.back() + serialized.back().size());
+            }
+        }
+        uint64_t sizes[2] = {pop.size(), offsets.back()};
+        MPI_Bcast(sizes, 2, MPI_UINT64_T, 0, nodeComm);
+        if (sizes[0] == noMoreBatch) return false;
+        const uint64_t n = sizes[0];
+        const size_t dataPos = sizeof(uint64_t) * (n + 2);
+
+        char *in = nullptr;
+        MPI_Win inWin;
+        MPI_Aint inSize = nodeRank == 0 ? static_cast<MPI_Aint>(dataPos + sizes[1]) : 0;
+        MPI_Win_allocate_shared(inSize, 1, MPI_INFO_NULL, nodeComm, &in, &inWin);
+        if (nodeRank == 0) {
+            new (in) std::atomic<uint64_t>(0);
+            std::memcpy(in + sizeof(uint64_t), offsets.data(), sizeof(uint64_t) * (n + 1));
+            for (size_t i = 0; i < serialized.size(); ++i)
+                std::memcpy(in + dataPos + offsets[i], serialized[i].data(),
+                            serialized[i].size());
+        } else {
+            MPI_Aint segSize;
+            int dispUnit;
+            MPI_Win_shared_query(inWin, 0, &segSize, &dispUnit, &in);
+        }
+        MPI_Win_fence(MPI_MODE_NOPRECEDE, inWin);
+
+        auto *next = reinterpret_cast<std::atomic<uint64_t> *>(in);
+        const uint64_t *off = reinterpret_cast<const uint64_t *>(in + sizeof(uint64_t));
+        const char *data = in + dataPos;
+        // the leader evaluates its own individuals in place, others work on copies
+        vector<std::pair<uint64_t, string>> results;
+#pragma omp parallel
         {
-            double fit_a = o.second;
-            double fit_b = b->fitnesses[o.first];
+            vector<std::pair<uint64_t, string>> local;
+            for (uint64_t i = next->fetch_add(1); i < n; i = next->fetch_add(1)) {
+                if (nodeRank == 0) {
+                    evaluateIndividual(pop[i]);
+                } else {
+                    Individual<DNA> ind(json::parse(string(data + off[i], off[i + 1] - off[i])));
+                    evaluateIndividual(ind);
+                    local.emplace_back(i, ind.toJSON().dump());
+                }
+            }
+#pragma omp critical
+            results.insert(results.end(), std::make_move_iterator(local.begin()),
+                           std::make_move_iterator(local.end()));
+        }
 
-            if (isBetter(fit_a, fit_b))         a_dominates = 1;
-            else if (isBetter(fit_b, fit_a))    b_dominates = 1;
+        size_t outSize = sizeof(uint64_t);
+        for (auto &r : results) outSize += 2 * sizeof(uint64_t) + r.second.size();
+        char *out = nullptr;
+        MPI_Win outWin;
+        MPI_Win_allocate_shared(static_cast<MPI_Aint>(outSize), 1, MPI_INFO_NULL, nodeComm,
+                                &out, &outWin);
+        uint64_t header = results.size();
+        std::memcpy(out, &header, sizeof(uint64_t));
+        size_t pos = sizeof(uint64_t);
+        for (auto &r : results) {
+            uint64_t rh[2] = {r.first, r.second.size()};
+            std::memcpy(out + pos, rh, sizeof(rh));
+            std::memcpy(out + pos + sizeof(rh), r.second.data(), r.second.size());
+            pos += sizeof(rh) + r.second.size();
+        }
+        MPI_Win_fence(MPI_MODE_NOPRECEDE, outWin);
+        if (nodeRank == 0) {
+            for (int r = 1; r < nodeSize; ++r) {
+                MPI_Aint segSize;
+                int dispUnit;
+                char *seg = nullptr;
+                MPI_Win_shared_query(outWin, r, &segSize, &dispUnit, &seg);
+                std::memcpy(&header, seg, sizeof(uint64_t));
+                pos = sizeof(uint64_t);
+                for (uint64_t k = 0; k < header; ++k) {
+                    uint64_t rh[2];
+                    std::memcpy(rh, seg + pos, sizeof(rh));
+                    pos += sizeof(rh);
+                    pop[rh[0]] = Individual<DNA>(json::parse(string(seg + pos, rh[1])));
+                    pos += rh[1];
+                }
+            }
         }
+        MPI_Win_fence(MPI_MODE_NOSUCCEED, outWin);
+        MPI_Win_fence(MPI_MODE_NOSUCCEED, inWin);
+        MPI_Win_free(&outWin);
+        MPI_Win_free(&inWin);
+        return true;
+    }
 
-        if (a_dominates >  b_dominates)         return  1;  // a dominates b
-        if (a_dominates <  b_dominates)         return -1;  // b dominates a
-        return 0;                                           // No one dominates the other
+    // tells the other ranks of the node that no more batch is coming for this round
+    static constexpr uint64_t noMoreBatch = std::numeric_limits<uint64_t>::max();
+    void MPI_endNodeRound() {
+        if (nodeSize == 1 || nodeRank != 0) return;
+        uint64_t sizes[2] = {noMoreBatch, 0};
+        MPI_Bcast(sizes, 2, MPI_UINT64_T, 0, nodeComm);
+    }
+#endif
+    /*********************************************************************************
+     *                          RESILIENT EVALUATION
+     ********************************************************************************/
+    // Enabled with enableResilientEvaluation(). Instead of receiving one static slice,
+    // workers (every other rank, or every other node leader in hybrid mode) pull batches
+    // of evalBatchSize individuals from the master, which only coordinates. Workers send
+    // heartbeats while evaluating, and get a new batch when they return their results.
+    // The bookkeeping is done by an EvalScheduler: the batch of a worker that stays silent
+    // for more than workerTimeout seconds goes to the survivors, and the master evaluates
+    // what's left itself if no worker remains. Every message carries the evaluation round,
+    // so a worker wrongly declared lost is readmitted as soon as it talks again, and late
+    // messages from a previous round are answered with TAG_ROUND_OVER. At the end of a
+    // round, every known worker, lost or not, is sent the TAG_ROUND_OVER of that round, so
+    // that none stays blocked in a probe; a worker ignores those of previous rounds.
+    // Heartbeats are sent between two evaluations: workerTimeout must be longer than the
+    // evaluation of one individual. Communicators are switched to MPI_ERRORS_RETURN, and a
+    // failed communication with a worker makes the master forget it at once (its batch
+    // goes back to the queue). Whether a job survives the death of a process still depends
+    // on the MPI runtime (e.g. Open MPI's mpirun --enable-recovery). Besides
+    // resumeFromCheckpoint, which runs before any worker can be lost, nothing then uses a
+    // collective on MPI_COMM_WORLD: novelty and NSGA-II sorts stay on the master (see
+    // nbCollectiveRanks), traces are sent point to point (see writeTrace), and finish()
+    // doesn't free the communicators.
+    void MPI_resilientEvaluation(std::vector<Individual<DNA>> &pop) {
+#ifdef OMP
+        if (nodeRank != 0) {  // non leaders are fed by their leader, batch after batch
+            while (MPI_evaluateOnNode(pop)) {
+            }
+            return;
+        }
+        MPI_Comm comm = leaderComm;
+#else
+        MPI_Comm comm = MPI_COMM_WORLD;
+#endif
+        MPI_Comm_set_errhandler(comm, MPI_ERRORS_RETURN);
+        if (procId == 0)
+            MPI_coordinateRound(pop, comm);
+        else
+            MPI_workerRound(comm);
+#ifdef OMP
+        MPI_endNodeRound();
+#endif
     }
 
-    bool paretoDominates(const Individual<DNA> &a, const Individual<DNA> &b) const {
-        for (auto &o : a.fitnesses)
-            if (!isBetter(o.second, b.fitnesses.at(o.first))) return false;
-        return true;
+    // a worker can't do without its master: failed communications throw
+    void MPI_workerRound(MPI_Comm comm) {
+        GAGA_TRACE_SPAN("MPI worker round");
+        const auto lostMaster = [&]() {
+            return std::runtime_error("Rank " + std::to_string(procId) + " lost the master");
+        };
+        if (MPI_Send(&evalRound, 1, MPI_UINT64_T, 0, TAG_REQUEST, comm) != MPI_SUCCESS)
+            throw lostMaster();
+        for (;;) {
+            MPI_Status status;
+            string msg;
+            if (MPI_Probe(0, MPI_ANY_TAG, comm, &status) != MPI_SUCCESS ||
+                !MPI_tryRecvString(status, comm, msg))
+                throw lostMaster();
+            if (status.MPI_TAG == TAG_ROUND_OVER) {
+                uint64_t round = evalRound;
+                if (msg.size() == sizeof(uint64_t)) std::memcpy(&round, msg.data(), sizeof(round));
+                if (round == evalRound) break;
+                continue;  // the end of a round this worker had already left
+            }
+            std::istringstream in(msg);
+            json o;
+            auto batch = Individual<DNA>::loadPopFromJSON(in, &o);
+            if (o.at("round") != evalRound) continue;
+            heartbeatComm = comm;
+            lastHeartbeat = EvalScheduler::clock::now();
+            sendHeartbeats = true;
+#ifdef OMP
+            MPI_evaluateOnNode(batch);
+#else
+            for (auto &ind : batch) evaluateIndividual(ind);
+#endif
+            sendHeartbeats = false;
+            std::ostringstream out;
+            Individual<DNA>::popToJSON(out, batch,
+                                       {{"round", evalRound}, {"indices", o.at("indices")}});
+            string resStr = out.str();
+            if (MPI_Send(resStr.data(), static_cast<int>(resStr.size()), MPI_BYTE, 0,
+                         TAG_RESULTS, comm) != MPI_SUCCESS)
+                throw lostMaster();
+        }
     }
 
-    vector<Individual<DNA> *> getParetoFront(
-            const std::vector<Individual<DNA> *> &ind) const {
-        // naive algorithm. Should be ok for small ind.size()
-        vector<Individual<DNA> *> pareto;
-        for (size_t i = 0; i < ind.size(); ++i) {
-            bool dominated = false;
-            for (auto &j : pareto) {
-                if (paretoDominates(*j, *ind[i])) {
-                    dominated = true;
-                    break;
-                }
+    void MPI_coordinateRound(std::vector<Individual<DNA>> &pop, MPI_Comm comm) {
+        GAGA_TRACE_SPAN("MPI coordination");
+        using clock = EvalScheduler::clock;
+        scheduler.setBatchSize(evalBatchSize);
+        scheduler.setTimeout(workerTimeout);
+        if (!workersRegistered) {  // first round: every other rank is a worker
+            int commSize;
+            MPI_Comm_size(comm, &commSize);
+            for (int w = 1; w < commSize; ++w) scheduler.join(w, clock::now());
+            workersRegistered = true;
+        }
+        scheduler.newRound(pop.size(), clock::now());
+
+        // a failed communication with a worker means it's gone
+        auto lose = [&](int w) {
+            if (verbosity >= 1 && scheduler.isAlive(w))
+                cerr << YELLOW << "Worker " << w << " failed, its batch goes back to the queue"
+                     << NORMAL << endl;
+            scheduler.leave(w);
+        };
+        auto send = [&](int w, int tag, string msg) {
+            pendingSends.push_back({MPI_REQUEST_NULL, w, std::move(msg)});
+            auto &s = pendingSends.back();
+            if (MPI_Isend(&s.msg[0], static_cast<int>(s.msg.size()), MPI_BYTE, w, tag, comm,
+                          &s.request) != MPI_SUCCESS) {
+                pendingSends.pop_back();
+                lose(w);
             }
-            if (!dominated) {
-                for (size_t j = i + 1; j < ind.size(); ++j) {
-                    if (paretoDominates(*ind[j], *ind[i])) {
-                        dominated = true;
-                        break;
-                    }
+        };
+        auto sendRoundOver = [&](int w, uint64_t round) {
+            send(w, TAG_ROUND_OVER, string(reinterpret_cast<const char *>(&round), sizeof(round)));
+        };
+        // Probes any worker. Once a rank has failed, a probe on any source can keep failing
+        // (e.g. with ULFM): the known workers are then probed one by one.
+        auto probe = [&](MPI_Status &status) {
+            int received = 0;
+            if (MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm, &received, &status) == MPI_SUCCESS)
+                return received != 0;
+            for (int w : scheduler.knownWorkers()) {
+                if (MPI_Iprobe(w, MPI_ANY_TAG, comm, &received, &status) != MPI_SUCCESS)
+                    lose(w);
+                else if (received)
+                    return true;
+            }
+            return false;
+        };
+        auto giveWork = [&](int w) {
+            auto tasks = scheduler.assign(w, clock::now());
+            if (tasks.empty()) return;
+            vector<Individual<DNA>> batch;
+            batch.reserve(tasks.size());
+            for (auto t : tasks) batch.push_back(pop[t]);
+            std::ostringstream out;
+            Individual<DNA>::popToJSON(out, batch, {{"round", evalRound}, {"indices", tasks}});
+            send(w, TAG_BATCH, out.str());
+        };
+
+        while (!scheduler.finished()) {
+            MPI_Status status;
+            if (probe(status)) {
+                int w = status.MPI_SOURCE;
+                string msg;
+                if (!MPI_tryRecvString(status, comm, msg)) {
+                    lose(w);
+                    continue;
+                }
+                json o;
+                vector<Individual<DNA>> batch;
+                uint64_t round = 0;
+                if (status.MPI_TAG == TAG_RESULTS) {
+                    std::istringstream in(msg);
+                    batch = Individual<DNA>::loadPopFromJSON(in, &o);
+                    round = o.at("round");
+                } else if (msg.size() == sizeof(uint64_t)) {
+                    std::memcpy(&round, msg.data(), sizeof(uint64_t));
+                }
+                if (round != evalRound) {  // leftover from a previous round
+                    if (status.MPI_TAG != TAG_HEARTBEAT) sendRoundOver(w, round);
+                    continue;
                 }
-                if (!dominated) {
-                    pareto.push_back(ind[i]);
+                if (status.MPI_TAG != TAG_HEARTBEAT && !scheduler.isAlive(w) && verbosity >= 1)
+                    cerr << YELLOW << "Worker " << w << " is back" << NORMAL << endl;
+                if (status.MPI_TAG == TAG_HEARTBEAT) {
+                    scheduler.heartbeat(w, clock::now());
+                } else if (status.MPI_TAG == TAG_RESULTS) {
+                    vector<size_t> tasks = o.at("indices");
+                    auto accepted = scheduler.complete(w, tasks, clock::now());
+                    unordered_set<size_t> keep(accepted.begin(), accepted.end());
+                    for (size_t i = 0; i < tasks.size() && i < batch.size(); ++i)
+                        if (keep.count(tasks[i])) pop[tasks[i]] = std::move(batch[i]);
+                    giveWork(w);
+                } else if (status.MPI_TAG == TAG_REQUEST) {
+                    giveWork(w);
                 }
+                continue;
             }
+            for (int w : scheduler.expire(clock::now()))
+                if (verbosity >= 1)
+                    cerr << YELLOW << "Worker " << w << " lost, its batch goes back to the queue"
+                         << NORMAL << endl;
+            for (int w : scheduler.waitingWorkers())
+                if (scheduler.nbPending() > 0) giveWork(w);
+            if (scheduler.nbAlive() == 0 && scheduler.nbPending() > 0) {
+                // no worker left, the master does the job
+                auto tasks = scheduler.takeLocal();
+                vector<Individual<DNA>> batch;
+                for (auto t : tasks) batch.push_back(std::move(pop[t]));
+#ifdef OMP
+                MPI_evaluateOnNode(batch);
+#else
+                for (auto &ind : batch) evaluateIndividual(ind);
+#endif
+                for (size_t i = 0; i < tasks.size(); ++i) pop[tasks[i]] = std::move(batch[i]);
+                scheduler.completeLocal(tasks);
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            for (int w : MPI_testPendingSends()) lose(w);
         }
-        return pareto;
+        // lost workers too: one that is still alive would otherwise wait forever
+        for (int w : scheduler.knownWorkers()) {
+            sendRoundOver(w, evalRound);
+            scheduler.dismiss(w);
+        }
+        for (int w : MPI_testPendingSends()) lose(w);
     }
 
-    Individual<DNA> *paretoTournament() {
-        std::uniform_int_distribution<size_t> dint(0, population.size() - 1);
-        std::vector<Individual<DNA> *> participants;
-        for (size_t i = 0; i < tournamentSize; ++i)
-            participants.push_back(&population[dint(globalRand)]);
-        auto pf = getParetoFront(participants);
-        assert(pf.size() > 0);
-        std::uniform_int_distribution<size_t> dpf(0, pf.size() - 1);
-        return pf[dpf(globalRand)];
+    // Forgets about completed sends (sends to lost workers might never complete), and
+    // returns the destinations of the failed ones
+    vector<int> MPI_testPendingSends() {
+        vector<int> failed;
+        pendingSends.remove_if([&](MPI_PendingSend &s) {
+            int completed = 0;
+            if (MPI_Test(&s.request, &completed, MPI_STATUS_IGNORE) == MPI_SUCCESS)
+                return completed != 0;
+            failed.push_back(s.dest);
+            return true;
+        });
+        return failed;
     }
-
-    Individual<DNA> *randomObjTournament() {
-        if (verbosity >= 3) cerr << "random obj tournament called" << endl;
-        std::uniform_int_distribution<size_t> dint(0, population.size() - 1);
-        std::vector<Individual<DNA> *> participants;
-        for (size_t i = 0; i < tournamentSize; ++i)
-            participants.push_back(&population[dint(globalRand)]);
-        auto champion = participants[0];
-        // we pick the objective randomly
-        std::string obj;
-        if (champion->fitnesses.size() == 1) {
-            obj = champion->fitnesses.begin()->first;
-        } else {
-            std::uniform_int_distribution<int> dObj(
-                    0, static_cast<int>(champion->fitnesses.size()) - 1);
-            auto it = champion->fitnesses.begin();
-            std::advance(it, dObj(globalRand));
-            obj = it->first;
-        }
-        for (size_t i = 1; i < tournamentSize; ++i) {
-            if (isBetter(participants[i]->fitnesses.at(obj), champion->fitnesses.at(obj)))
-                champion = participants[i];
-        }
-        if (verbosity >= 3) cerr << "champion found" << endl;
-        return champion;
+#endif
+#ifdef SOCKET_WORKERS
+    /*********************************************************************************
+     *                             SOCKET WORKERS
+     ********************************************************************************/
+    // Alternative to MPI for pools of long lived worker processes. The master listens
+    // (enableSocketWorkers) and workers connect whenever they want (runWorker), ask for
+    // work and get batches of evalBatchSize individuals encoded with the binary codec.
+    // Scheduling is the same as the resilient MPI evaluation (EvalScheduler): a worker
+    // that disconnects leaves, its batch is requeued, as is the batch of a worker silent
+    // for more than workerTimeout seconds; the master evaluates the remaining individuals
+    // itself when no worker is connected.
+
+    // [round][nb individuals]([index])*([individual])*
+    static string encodeBatch(uint64_t round, const vector<size_t> &tasks,
+                              const vector<Individual<DNA>> &batch) {
+        string out;
+        binaryPut(out, round);
+        binaryPut(out, static_cast<uint64_t>(tasks.size()));
+        for (auto t : tasks) binaryPut(out, static_cast<uint64_t>(t));
+        for (const auto &ind : batch) ind.toBinary(out);
+        return out;
     }
 
-    std::vector<std::vector<Individual<DNA>*>> paretoFronts;
-    void nsga2SortPopulation(std::vector<Individual<DNA>>& pop)
-    {
-        paretoFronts.clear();
-        std::vector<Individual<DNA>*> currentFront;
-        std::vector<Individual<DNA>*> lastFront;
-        int currentRank = 1;
-        int placedIndivs = 0;
-
-        for (size_t pid = 0; pid < pop.size(); ++pid)
-        {
-            Individual<DNA>* p = &pop[pid];
-            p->np = 0;
-            p->sp.clear();
-
-            for (size_t qid = 0; qid < pop.size(); ++qid)
-            {
-                if (pid == qid) continue;
-                Individual<DNA>* q = &pop[qid];
+    static void decodeBatch(const string &in, uint64_t &round, vector<size_t> &tasks,
+                            vector<Individual<DNA>> &batch) {
+        const char *cur = in.data(), *end = in.data() + in.size();
+        round = binaryGet<uint64_t>(cur, end);
+        tasks.resize(binaryGet<uint64_t>(cur, end));
+        for (auto &t : tasks) t = binaryGet<uint64_t>(cur, end);
+        batch.clear();
+        batch.reserve(tasks.size());
+        for (size_t i = 0; i < tasks.size(); ++i)
+            batch.push_back(Individual<DNA>::fromBinary(cur, end));
+    }
 
-                int cmp = nsga2ParetoDominates(p, q);
-                if      (cmp > 0)   p->sp.push_back(q); // p dominates q
-                else if (cmp < 0)   p->np++;            // q dominates p
+    void socketEvaluation(std::vector<Individual<DNA>> &pop) {
+        GAGA_TRACE_SPAN("socket evaluation");
+        using clock = EvalScheduler::clock;
+        scheduler.setBatchSize(evalBatchSize);
+        scheduler.setTimeout(workerTimeout);
+        scheduler.newRound(pop.size(), clock::now());
+
+        auto dropWorker = [&](int w) {
+            scheduler.leave(w);
+            workerSockets.erase(w);
+            if (verbosity >= 1) cerr << YELLOW << "Worker " << w << " left" << NORMAL << endl;
+        };
+        auto giveWork = [&](int w) {
+            auto tasks = scheduler.assign(w, clock::now());
+            if (tasks.empty()) return;
+            vector<Individual<DNA>> batch;
+            batch.reserve(tasks.size());
+            for (auto t : tasks) batch.push_back(pop[t]);
+            if (!workerSockets.at(w).send(Socket::BATCH, encodeBatch(evalRound, tasks, batch)))
+                dropWorker(w);
+        };
+
+        for (int w : scheduler.waitingWorkers()) giveWork(w);
+        vector<pollfd> fds;
+        vector<int> ids;
+        while (!scheduler.finished()) {
+            for (Socket s = workersListener.accept(); s.valid(); s = workersListener.accept()) {
+                int w = nextWorkerId++;
+                workerSockets.emplace(w, std::move(s));
+                scheduler.join(w, clock::now());
+                if (verbosity >= 1) cerr << GREEN << "Worker " << w << " joined" << NORMAL << endl;
+            }
+            bool evaluateLocally = scheduler.nbAlive() == 0 && scheduler.nbPending() > 0;
+            fds.assign(1, {workersListener.handle(), POLLIN, 0});
+            ids.assign(1, 0);
+            for (auto &ws : workerSockets) {
+                fds.push_back({ws.second.handle(), POLLIN, 0});
+                ids.push_back(ws.first);
+            }
+            ::poll(fds.data(), fds.size(), evaluateLocally ? 0 : 1);
+            for (size_t i = 1; i < fds.size(); ++i) {
+                if (!fds[i].revents) continue;
+                int w = ids[i];
+                auto &sock = workerSockets.at(w);
+                bool connected = sock.fill();
+                uint32_t type;
+                string payload;
+                while (sock.pop(type, payload)) {
+                    if (type == Socket::HEARTBEAT) {
+                        scheduler.heartbeat(w, clock::now());
+                    } else if (type == Socket::RESULTS) {
+                        uint64_t round;
+                        vector<size_t> tasks;
+                        vector<Individual<DNA>> batch;
+                        decodeBatch(payload, round, tasks, batch);
+                        if (round == evalRound) {  // else leftover from a previous round
+                            auto accepted = scheduler.complete(w, tasks, clock::now());
+                            unordered_set<size_t> keep(accepted.begin(), accepted.end());
+                            for (size_t k = 0; k < tasks.size(); ++k)
+                                if (keep.count(tasks[k])) pop[tasks[k]] = std::move(batch[k]);
+                        }
+                        giveWork(w);
+                    } else if (type == Socket::REQUEST) {
+                        giveWork(w);
+                    }
+                    if (!workerSockets.count(w)) break;  // dropped while sending
+                }
+                if (!connected && workerSockets.count(w)) dropWorker(w);
+            }
+            for (int w : scheduler.expire(clock::now()))
+                if (verbosity >= 1)
+                    cerr << YELLOW << "Worker " << w << " lost, its batch goes back to the queue"
+                         << NORMAL << endl;
+            for (int w : scheduler.waitingWorkers())
+                if (scheduler.nbPending() > 0) giveWork(w);
+            if (evaluateLocally) {  // no worker around, the master does the job
+                auto tasks = scheduler.takeLocal();
+#ifdef OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+                for (size_t i = 0; i < tasks.size(); ++i) evaluateIndividual(pop[tasks[i]]);
+                scheduler.completeLocal(tasks);
             }
+        }
+    }
 
-            if (p->np == 0)
-            {
-                currentFront.push_back(p);
-                ++placedIndivs;
-                p->paretoRank = currentRank;
+    // master side: starts listening for workers ("tcp://host:port" or "unix:///path")
+    void enableSocketWorkers(const string &address) {
+        workersListener = Socket::listen(address);
+        workersAddress = address;
+    }
+
+    // Worker side: connects to a master and evaluates the batches it sends until it says
+    // goodbye (returns true) or the connection is lost (returns false). Only the evaluator
+    // (and newGenerationFunction, called whenever a new generation starts) is used.
+    bool runWorker(const string &address) {
+        if (!evaluator) throw std::invalid_argument("No evaluator specified");
+        Socket master = Socket::connect(address);
+        masterSocket = &master;
+        struct MasterReset {  // master dies with this call, even when the evaluator throws
+            GA &ga;
+            ~MasterReset() { ga.masterSocket = nullptr; }
+        } masterReset{*this};
+        uint32_t type = 0;
+        string payload;
+        bool connected = master.send(Socket::REQUEST, "");
+        while (connected && master.receive(type, payload)) {
+            if (type == Socket::BYE) break;
+            if (type != Socket::BATCH) continue;
+            uint64_t round;
+            vector<size_t> tasks;
+            vector<Individual<DNA>> batch;
+            decodeBatch(payload, round, tasks, batch);
+            if (round != evalRound) {
+                evalRound = round;
+                newGenerationFunction();
             }
+            lastHeartbeat = EvalScheduler::clock::now();
+            sendHeartbeats = true;
+#ifdef OMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+            for (size_t i = 0; i < batch.size(); ++i) evaluateIndividual(batch[i]);
+            sendHeartbeats = false;
+            connected = master.send(Socket::RESULTS, encodeBatch(round, tasks, batch));
         }
+        return connected && type == Socket::BYE;
+    }
+#endif
+    /*********************************************************************************
+     *                            NEXT POP GETTING READY
+     ********************************************************************************/
+    // Là où qu'on fait les bébés.
+    // The previous generation's buffer (lastGen) receives the offspring, then swaps roles
+    // with the population: the parents become lastGen without any copy. DNA is only copied
+    // for elites and for parents passed on without crossover, and the offspring reuse the
+    // storage of the retiring generation.
+    void prepareNextPop() {
+        GAGA_TRACE_SPAN("breeding");
+        assert(tournamentSize > 0);
+        assert(population.size() == popSize);
+        vector<Individual<DNA>> &nextGen = lastGen;
+        retire(nextGen);
+        nextGen.reserve(popSize);
 
-        paretoFronts.push_back(currentFront);
-        while (placedIndivs != pop.size())
-        {
-            ++currentRank;
-            lastFront = currentFront;
-            currentFront.clear();
+        // elitism
+        if (selecMethod != SelectionMethod::nsga2Tournament) {
+            const EliteSet &elites = getEliteIndices(nbElites);
+            for (size_t o = 0; o < elites.rows.size(); ++o)
+                for (size_t k = 0; k < nbElites && k < elites.size(o); ++k)
+                    recycledSlot(nextGen) = population[elites.rows[o][k]];
+        }
 
-            for (size_t pid = 0; pid < lastFront.size(); ++pid)
-            {
-                Individual<DNA>* p = lastFront[pid];
+        if (verbosity >= 3) cerr << "preparing rest of the population" << endl;
+        const size_t firstBred = nextGen.size();
+        while (nextGen.size() < popSize) recycledSlot(nextGen);
+
+        // two parents per offspring, selected at once from the generation's stream (the
+        // second one is only used for crossovers)
+        const size_t nbBred = popSize - firstBred;
+        RandomEngine selectionRng = breedingStream(std::numeric_limits<uint64_t>::max());
+        selection(ObjectiveMatrix(population), 2 * nbBred, selectionRng, selectedParents);
+#ifdef OMP
+#pragma omp parallel for schedule(dynamic, 1) if (parallelBreeding)
+#endif
+        for (size_t k = firstBred; k < nextGen.size(); ++k) {
+            const size_t j = 2 * (k - firstBred);
+            breedOffspring(nextGen[k], k, population[selectedParents[j]],
+                           population[selectedParents[j + 1]]);
+        }
+        if (verbosity >= 3) cerr << "done" << endl;
+        assert(nextGen.size() == popSize);
+        // Save this generation
+        population.swap(lastGen);
+        elitesCached = false;
+        if (verbosity >= 3) cerr << "done completely" << endl;
+    }
 
-                for (auto q : p->sp)
-                {
-                    --q->np;
+    // random stream of an offspring slot of the current generation
+    RandomEngine breedingStream(uint64_t slot) const {
+        return randomStreams.stream(currentGeneration, slot);
+    }
 
-                    if (q->np == 0)
-                    {
-                        q->paretoRank = currentRank;
-                        ++placedIndivs;
-                        currentFront.push_back(q);
-                    }
-                }
-            }
+    // crossover + mutation of the offspring of a given slot (a recycled individual) from
+    // its selected parents
+    void breedOffspring(Individual<DNA> &offspring, size_t slot, Individual<DNA> &p0,
+                        Individual<DNA> &p1) {
+        RandomEngine rng = breedingStream(slot);
+        std::uniform_real_distribution<double> d(0.0, 1.0);
+        if (d(rng) < crossoverProba) {
+            offspring.recycle(fitnessRecycling);
+            dnaCrossoverInto(p0.dna, p1.dna, offspring.dna, rng);
+        } else {
+            offspring = p0;
+        }
+        if (d(rng) < mutationProba) {
+            dnaMutate(offspring.dna, rng);
+            offspring.evaluated = false;
+        }
+    }
 
-            if (!currentFront.empty())
-            {
-                paretoFronts.push_back(currentFront);
+    // NSGA-II version: two tournaments among population slots (a0, a1) and (a2, a3) give
+    // the parents of c0 and c1
+    void nsga2BreedPair(size_t a0, size_t a1, size_t a2, size_t a3, Individual<DNA> &c0,
+                        Individual<DNA> &c1, size_t slot) {
+        RandomEngine rng = breedingStream(slot);
+        std::uniform_real_distribution<double> d(0.0, 1.0);
+        Individual<DNA> &p0 = population[nsga2Tournament(a0, a1, rng)];
+        Individual<DNA> &p1 = population[nsga2Tournament(a2, a3, rng)];
+        if (d(rng) < crossoverProba) {
+            c0.recycle(fitnessRecycling);
+            c1.recycle(fitnessRecycling);
+            dnaCrossover(p0.dna, p1.dna, c0.dna, c1.dna, rng);
+        } else {
+            c0 = p0;
+            c1 = p1;
+        }
+        for (auto c : {&c0, &c1}) {
+            if (d(rng) < mutationProba) {
+                dnaMutate(c->dna, rng);
+                c->evaluated = false;
             }
         }
+    }
 
-        // Get all fitness names
-        std::vector<std::string> fitnessNames;
-        for (auto f : paretoFronts[0][0]->fitnesses)
-        {
-            fitnessNames.push_back(f.first);
+    // Moves the individuals of pop to the spare pool, leaving pop empty.
+    void retire(vector<Individual<DNA>> &pop) {
+        spareIndividuals.reserve(spareIndividuals.size() + pop.size());
+        std::move(pop.begin(), pop.end(), std::back_inserter(spareIndividuals));
+        pop.clear();
+    }
+
+    // Appends an individual to pop, taken from the spare pool when possible so that its
+    // containers (and dna) already have some storage. Its content is unspecified: it is
+    // meant to be assigned to, or recycle()d before its dna is overwritten.
+    Individual<DNA> &recycledSlot(vector<Individual<DNA>> &pop) {
+        if (spareIndividuals.empty()) {
+            pop.emplace_back();
+        } else {
+            pop.push_back(std::move(spareIndividuals.back()));
+            spareIndividuals.pop_back();
         }
+        return pop.back();
+    }
+
+    int nsga2ParetoDominates(Individual<DNA>* a, Individual<DNA>* b)
+    {
+        int a_dominates = 0;
+        int b_dominates = 0;
 
-        // Compute crowding distances
-        for (auto& f : paretoFronts)
+        for (auto o : a->fitnesses)
         {
-            size_t n = f.size();
+            double fit_a = o.second;
+            double fit_b = b->fitnesses[o.first];
 
-            // init distance to 0
-            for (auto ind : f)
-            {
-                ind->crowdingDistance = 0;
-            }
+            if (isBetter(fit_a, fit_b))         a_dominates = 1;
+            else if (isBetter(fit_b, fit_a))    b_dominates = 1;
+        }
 
-            for (auto fit : fitnessNames)
-            {
-                // Sort population given fitness
-                if (n > 1)
-                {
-                    std::sort(f.begin(), f.end(),
-                            [&](Individual<DNA>* a, Individual<DNA>* b)
-                            {
-                            return isBetter(a->fitnesses[fit], b->fitnesses[fit]);
-                            });
+        if (a_dominates >  b_dominates)         return  1;  // a dominates b
+        if (a_dominates <  b_dominates)         return -1;  // b dominates a
+        return 0;                                           // No one dominates the other
+    }
 
-                    f[n-1]->crowdingDistance = std::numeric_limits<double>::infinity();
-                }
+    bool paretoDominates(const Individual<DNA> &a, const Individual<DNA> &b) const {
+        for (auto &o : a.fitnesses)
+            if (!isBetter(o.second, b.fitnesses.at(o.first))) return false;
+        return true;
+    }
 
-                f[0]->crowdingDistance = std::numeric_limits<double>::infinity();
+    // first front of ind, in the order of ind
+    vector<Individual<DNA> *> getParetoFront(
+            const std::vector<Individual<DNA> *> &ind) const {
+        ParetoFrontExtractor extractor;
+        vector<bool> onFront;
+        extractor.extract(ObjectiveMatrix(ind), isBetter, onFront);
+        vector<Individual<DNA> *> pareto;
+        for (size_t i = 0; i < ind.size(); ++i)
+            if (onFront[i]) pareto.push_back(ind[i]);
+        return pareto;
+    }
 
-                double fmin = f[0]->fitnesses[fit];
-                double fmax = f[n-1]->fitnesses[fit];
-                double denom = fmax - fmin;
+    // onFront[i] is true if pop[i] is on the first front
+    vector<bool> getParetoFrontMembership(const std::vector<Individual<DNA>> &pop) {
+        vector<bool> onFront;
+        paretoFrontExtractor.extract(ObjectiveMatrix(pop), isBetter, onFront);
+        return onFront;
+    }
 
-                for (size_t i = 1; i < n - 1; ++i)
-                {
-                    double a = f[i+1]->fitnesses[fit];
-                    double b = f[i-1]->fitnesses[fit];
-                    f[i]->crowdingDistance += (a - b) / denom;
-                }
-            }
-        }
+    TournamentSelector tournamentSelector;
+    EliteSelector eliteSelector;
+    EliteSet cachedElites;          // see getEliteIndices
+    bool elitesCached = false;      // reset whenever the population changes
+    size_t elitesCachedSize = 0;
+    ParetoFrontExtractor paretoFrontExtractor;
+    vector<uint32_t> selectedParents;  // winners of the current generation's tournaments
+    ParetoRanking paretoRanking;       // of the population, when using NSGA-II
+    ParetoRanking mixedRanking;        // of the parents and children (see nsga2Step)
+    // Sorts pop on its own (with a local sorter, so that it doesn't interfere with the
+    // current generation's ranking)
+    ParetoRanking nsga2SortPopulation(const std::vector<Individual<DNA>>& pop) const
+    {
+        NSGA2Sorter sorter;
+        ParetoRanking res;
+        sorter.sort(ObjectiveMatrix(pop), isBetter, res);
+        return res;
+    }
 
+#ifdef CLUSTER
+    // Collective version of nsga2SortPopulation (not used with resilientEval, see
+    // nbCollectiveRanks): the objective matrix is broadcast and every rank computes the
+    // domination data of a block of rows, which the master gathers before peeling the
+    // fronts. Only the master's pop is read, and only its res is filled.
+    void MPI_nsga2SortPopulation(const std::vector<Individual<DNA>>& pop, ParetoRanking &res)
+    {
+        ObjectiveMatrix obj;
+        if (procId == 0) obj = ObjectiveMatrix(pop);
+        uint64_t dims[2] = {obj.nbRows, obj.names.size()};
+        MPI_Bcast(dims, 2, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+        if (procId != 0) {
+            obj.nbRows = dims[0];
+            obj.names.resize(dims[1]);
+            obj.values.resize(dims[0] * dims[1]);
+        }
+        MPI_Bcast(obj.values.data(), static_cast<int>(obj.values.size()), MPI_DOUBLE, 0,
+                  MPI_COMM_WORLD);
+
+        const size_t n = obj.nbRows;
+        auto blockStart = [&](int r) { return n * static_cast<size_t>(r) / nbProcs; };
+        size_t begin = blockStart(procId), end = blockStart(procId + 1);
+        nsga2Sorter.computeDominations(obj, begin, end, isBetter);
+        const auto &np = nsga2Sorter.dominationCounts();
+        const auto &sp = nsga2Sorter.dominatedSets();
+
+        // per row: np, then the size of sp; then all the sp concatenated
+        std::vector<int> rowCounts(nbProcs), rowDispls(nbProcs);
+        for (int r = 0; r < nbProcs; ++r) {
+            rowDispls[r] = static_cast<int>(blockStart(r));
+            rowCounts[r] = static_cast<int>(blockStart(r + 1) - blockStart(r));
+        }
+        std::vector<int> spSizes(end - begin);
+        std::vector<uint32_t> spData;
+        for (size_t i = 0; i < sp.size(); ++i) {
+            spSizes[i] = static_cast<int>(sp[i].size());
+            spData.insert(spData.end(), sp[i].begin(), sp[i].end());
+        }
+        std::vector<int> allNp(procId == 0 ? n : 0), allSpSizes(procId == 0 ? n : 0);
+        MPI_Gatherv(np.data(), rowCounts[procId], MPI_INT, allNp.data(), rowCounts.data(),
+                    rowDispls.data(), MPI_INT, 0, MPI_COMM_WORLD);
+        MPI_Gatherv(spSizes.data(), rowCounts[procId], MPI_INT, allSpSizes.data(),
+                    rowCounts.data(), rowDispls.data(), MPI_INT, 0, MPI_COMM_WORLD);
+        int dataCount = static_cast<int>(spData.size());
+        std::vector<int> dataCounts(nbProcs), dataDispls(nbProcs);
+        MPI_Gather(&dataCount, 1, MPI_INT, dataCounts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+        std::vector<uint32_t> allSpData;
+        if (procId == 0) {
+            for (int r = 1; r < nbProcs; ++r) dataDispls[r] = dataDispls[r - 1] + dataCounts[r - 1];
+            allSpData.resize(dataDispls[nbProcs - 1] + dataCounts[nbProcs - 1]);
+        }
+        MPI_Gatherv(spData.data(), dataCount, MPI_UINT32_T, allSpData.data(), dataCounts.data(),
+                    dataDispls.data(), MPI_UINT32_T, 0, MPI_COMM_WORLD);
+        if (procId != 0) return;
+
+        nsga2Sorter.dominationCounts() = allNp;
+        auto &allSp = nsga2Sorter.dominatedSets();
+        allSp.resize(n);
+        auto it = allSpData.begin();
+        for (size_t i = 0; i < n; ++i) {
+            allSp[i].assign(it, it + allSpSizes[i]);
+            it += allSpSizes[i];
+        }
+        nsga2Sorter.rank(obj, isBetter, res);
+    }
+#endif
 
-        nsga2SaveFront();
+    // sorts pop using the first nbCollectiveRanks() ranks (must then be called by all of them)
+    void nsga2SortAllRanks(const std::vector<Individual<DNA>>& pop, ParetoRanking &res)
+    {
+        if (procId >= nbCollectiveRanks()) return;
+        GAGA_TRACE_SPAN("NSGA-II sort");
+#ifdef CLUSTER
+        if (nbCollectiveRanks() > 1) {
+            MPI_nsga2SortPopulation(pop, res);
+            return;
+        }
+#endif
+        nsga2Sorter.sort(ObjectiveMatrix(pop), isBetter, res);
     }
 
     /*
@@ -932,16 +4430,16 @@ template <typename DNA> class GA {
     }
     */
 
-    Individual<DNA>* nsga2Tournament(Individual<DNA>* a, Individual<DNA>* b)
+    // crowded comparison of two slots of the population
+    size_t nsga2Tournament(size_t a, size_t b, RandomEngine &rng)
     {
-        if      (a->paretoRank          < b->paretoRank)        return a;
-        else if (b->paretoRank          < a->paretoRank)        return b;
-        else if (a->crowdingDistance    > b->crowdingDistance)  return a;
-        else if (b->crowdingDistance    > a->crowdingDistance)  return b;
+        int cmp = paretoRanking.compare(a, b);
+        if      (cmp > 0)   return a;
+        else if (cmp < 0)   return b;
 
         // Could not find the better guy, select randomly
         std::uniform_int_distribution<size_t> ht(0, 1);
-        return (ht(globalRand) == 0 ? a : b);
+        return (ht(rng) == 0 ? a : b);
     }
 
     vector<Individual<DNA>> getLastParetoFront()
@@ -949,35 +4447,52 @@ template <typename DNA> class GA {
         vector<Individual<DNA>> result;
         if (selecMethod == SelectionMethod::nsga2Tournament)
         {
-            nsga2SortPopulation(lastGen);
+            auto ranking = nsga2SortPopulation(lastGen);
 
-            for (auto ind : paretoFronts[0])
+            if (!ranking.fronts.empty())
             {
-                result.push_back(*ind);
+                for (auto i : ranking.fronts[0])
+                {
+                    result.push_back(lastGen[i]);
+                }
             }
         }
         else
         {
-            vector<Individual<DNA>*> pop;
-
-            for (auto &p : lastGen) {
-                pop.push_back(&p);
-            }
-
-            auto front = getParetoFront(pop);
+            auto onFront = getParetoFrontMembership(lastGen);
 
-            for (auto& p : front)
+            for (size_t i = 0; i < lastGen.size(); ++i)
             {
-                result.push_back(*p);
+                if (onFront[i]) result.push_back(lastGen[i]);
             }
         }
         return result;
     }
 
+    // Elites of the population, as population slots (at least the n best of each
+    // objective, best first). They are computed once per generation for the largest of
+    // n, nbElites and nbSavedElites, and shared by the saves and the breeding.
+    const EliteSet &getEliteIndices(size_t n) {
+        if (!elitesCached || elitesCachedSize < n) {
+            GAGA_TRACE_SPAN("elites");
+            elitesCachedSize = std::max(n, std::max(nbElites, nbSavedElites));
+            if (verbosity >= 3) cerr << "computing elites, n = " << elitesCachedSize << endl;
+            eliteSelector.select(ObjectiveMatrix(population), elitesCachedSize, isBetter,
+                                 cachedElites);
+            elitesCached = true;
+        }
+        return cachedElites;
+    }
+
     unordered_map<string, vector<Individual<DNA>>> getElites(size_t n) {
-        vector<string> obj;
-        for (auto &o : population[0].fitnesses) obj.push_back(o.first);
-        return getElites(obj, n, population);
+        unordered_map<string, vector<Individual<DNA>>> elites;
+        if (selecMethod == SelectionMethod::nsga2Tournament) return elites;
+        const EliteSet &e = getEliteIndices(n);
+        for (size_t o = 0; o < e.objectives.size(); ++o) {
+            auto &v = elites[e.objectives[o]];
+            for (size_t k = 0; k < n && k < e.size(o); ++k) v.push_back(population[e.rows[o][k]]);
+        }
+        return elites;
     }
     unordered_map<string, vector<Individual<DNA>>> getLastGenElites(size_t n) {
         vector<string> obj;
@@ -986,32 +4501,20 @@ template <typename DNA> class GA {
     }
     unordered_map<string, vector<Individual<DNA>>> getElites(
             const vector<string> &obj, size_t n, const vector<Individual<DNA>> &popVec) {
-
-
         if (verbosity >= 3) {
             cerr << "getElites : nbObj = " << obj.size() << " n = " << n << endl;
         }
         unordered_map<string, vector<Individual<DNA>>> elites;
 
         if (selecMethod == SelectionMethod::nsga2Tournament) return elites;
-        for (auto &o : obj) {
-            elites[o] = vector<Individual<DNA>>();
-            elites[o].push_back(popVec[0]);
-            size_t worst = 0;
-            for (size_t i = 1; i < n && i < popVec.size(); ++i) {
-                elites[o].push_back(popVec[i]);
-                if (isBetter(elites[o][worst].fitnesses.at(o), popVec[i].fitnesses.at(o)))
-                    worst = i;
-            }
-            for (size_t i = n; i < popVec.size(); ++i) {
-                if (isBetter(popVec[i].fitnesses.at(o), elites[o][worst].fitnesses.at(o))) {
-                    elites[o][worst] = popVec[i];
-                    for (size_t j = 0; j < n; ++j) {
-                        if (isBetter(elites[o][worst].fitnesses.at(o), elites[o][j].fitnesses.at(o)))
-                            worst = j;
-                    }
-                }
-            }
+        EliteSelector selector;
+        EliteSet e;
+        selector.select(ObjectiveMatrix(popVec), n, isBetter, e);
+        for (size_t o = 0; o < e.objectives.size(); ++o) {
+            if (std::find(obj.begin(), obj.end(), e.objectives[o]) == obj.end()) continue;
+            auto &v = elites[e.objectives[o]];
+            v.reserve(e.size(o));
+            for (auto i : e.rows[o]) v.push_back(popVec[i]);
         }
         return elites;
     }
@@ -1085,56 +4588,165 @@ template <typename DNA> class GA {
         }
         return avgDist;
     }
+    static double getFootprintDistance(const double *f0, const double *f1, size_t size) {
+        double d = 0;
+        for (size_t i = 0; i < size; ++i) d += (f0[i] - f1[i]) * (f0[i] - f1[i]);
+        return sqrt(d);
+    }
+
+    // appends the footprint's snapshots to out, returns the number of values appended
+    static size_t flattenFootprint(const fpType &fp, vector<double> &out) {
+        size_t size = 0;
+        for (const auto &snapshot : fp) {
+            out.insert(out.end(), snapshot.begin(), snapshot.end());
+            size += snapshot.size();
+        }
+        return size;
+    }
+
+    // Novelty of an individual is its average distance to its KNN nearest neighbours among
+    // the archive and the current population (itself included). The archive's footprints
+    // are sharded across MPI ranks: entry i of the archive is held by rank i % nbProcs.
+    // Every rank computes, for each individual, its KNN nearest neighbours among its shard
+    // and its share of the population (one individual out of nbProcs), and the master
+    // merges these partial top-K lists. Without MPI there's a single shard. Only the
+    // master keeps whole archived individuals (for saving).
+    // Collective: the archive is sharded over the first nbCollectiveRanks() ranks, which
+    // must all call it (the others return at once)
     void updateNovelty() {
-        if (verbosity >= 2) {
+        const size_t nbRanks = static_cast<size_t>(nbCollectiveRanks());
+        const size_t rank = static_cast<size_t>(procId);
+        if (rank >= nbRanks) return;
+        GAGA_TRACE_SPAN("novelty");
+        if (procId == 0 && verbosity >= 2) {
             cout << endl << endl;
             std::stringstream output;
             cout << GREY << " ❯❯  " << YELLOW << "COMPUTING NOVELTY " << NORMAL << " ⤵  "
                 << endl
                 << endl;
         }
-        auto savedArchiveSize = archive.size();
-        for (auto &ind : population) {
-            archive.push_back(ind);
+        // every rank gets the footprints of the population
+        vector<double> popFp;
+        uint64_t dims[2] = {0, 0};  // nb of individuals, footprint size
+        if (procId == 0) {
+            assert(population.size());
+            dims[0] = population.size();
+            for (const auto &ind : population) dims[1] = flattenFootprint(ind.footprint, popFp);
+            assert(popFp.size() == dims[0] * dims[1]);  // footprints must have the same size
+        }
+#ifdef CLUSTER
+        if (nbRanks > 1) {
+            MPI_Bcast(dims, 2, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+            popFp.resize(dims[0] * dims[1]);
+            MPI_Bcast(popFp.data(), static_cast<int>(popFp.size()), MPI_DOUBLE, 0,
+                      MPI_COMM_WORLD);
+        }
+#endif
+        const size_t n = dims[0], dim = dims[1], K = KNN;
+
+        // partial knn distances of each individual, padded with infinity (n * K values)
+        vector<double> partial(n * K, std::numeric_limits<double>::infinity());
+        const size_t shardSize = dim > 0 ? archiveShard.size() / dim : archiveShard.size();
+#ifdef OMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (size_t i = 0; i < n; ++i) {
+            vector<double> d;
+            d.reserve(shardSize + n / nbRanks + 1);
+            const double *fp = popFp.data() + i * dim;
+            for (size_t a = 0; a < shardSize; ++a)
+                d.push_back(getFootprintDistance(fp, archiveShard.data() + a * dim, dim));
+            for (size_t j = rank; j < n; j += nbRanks)
+                d.push_back(getFootprintDistance(fp, popFp.data() + j * dim, dim));
+            size_t k = std::min(K, d.size());
+            std::nth_element(d.begin(), d.begin() + static_cast<std::ptrdiff_t>(k), d.end());
+            std::copy(d.begin(), d.begin() + static_cast<std::ptrdiff_t>(k),
+                      partial.begin() + static_cast<std::ptrdiff_t>(i * K));
+        }
+
+        vector<double> allPartials;
+#ifdef CLUSTER
+        if (nbRanks > 1) {
+            if (procId == 0) allPartials.resize(partial.size() * nbRanks);
+            MPI_Gather(partial.data(), static_cast<int>(partial.size()), MPI_DOUBLE,
+                       allPartials.data(), static_cast<int>(partial.size()), MPI_DOUBLE, 0,
+                       MPI_COMM_WORLD);
         }
-        std::pair<Individual<DNA> *, double> best = {&population[0], 0};
-        vector<Individual<DNA>> toBeAdded;
-        for (auto &ind : population) {
-            double avgD = computeAvgDist(KNN, archive, ind.footprint);
-            bool added = false;
-            if (avgD > minNoveltyForArchive) {
-                toBeAdded.push_back(ind);
-                added = true;
+#endif
+        if (nbRanks == 1) allPartials = std::move(partial);
+
+        vector<uint64_t> added;  // indices of the individuals that enter the archive
+        if (procId == 0) {
+            auto savedArchiveSize = archive.size();
+            const size_t nbNeighbours = std::min(K, archiveCount + n);
+            std::pair<size_t, double> best = {0, 0};
+            vector<double> knn;
+            for (size_t i = 0; i < n; ++i) {
+                auto &ind = population[i];
+                knn.clear();
+                for (size_t r = 0; r < nbRanks; ++r) {
+                    auto first = allPartials.data() + (r * n + i) * K;
+                    knn.insert(knn.end(), first, first + K);
+                }
+                double avgD = 0;
+                if (archiveCount + n > 1 && nbNeighbours > 0) {
+                    std::nth_element(knn.begin(),
+                                     knn.begin() + static_cast<std::ptrdiff_t>(nbNeighbours),
+                                     knn.end());
+                    for (size_t k = 0; k < nbNeighbours; ++k) avgD += knn[k];
+                    avgD /= static_cast<double>(nbNeighbours);
+                }
+                bool isAdded = false;
+                if (avgD > minNoveltyForArchive) {
+                    added.push_back(i);
+                    isAdded = true;
+                }
+                if (avgD > best.second) best = {i, avgD};
+                if (verbosity >= 2) {
+                    std::stringstream output;
+                    output << GREY << " ❯ " << endl
+                        << NORMAL << ind.infos << endl
+                        << " -> Novelty = " << CYAN << avgD << GREY
+                        << (isAdded ? " (added to archive)" : " (too low for archive)") << NORMAL;
+                    if (verbosity >= 3)
+                        output << "Footprint was : " << footprintToString(ind.footprint);
+                    output << endl;
+                    std::cout << output.str();
+                }
+                ind.fitnesses["novelty"] = avgD;
             }
-            if (avgD > best.second) best = {&ind, avgD};
+            for (auto i : added) archive.push_back(population[i]);
             if (verbosity >= 2) {
                 std::stringstream output;
-                output << GREY << " ❯ " << endl
-                    << NORMAL << ind.infos << endl
-                    << " -> Novelty = " << CYAN << avgD << GREY
-                    << (added ? " (added to archive)" : " (too low for archive)") << NORMAL;
-                if (verbosity >= 3)
-                    output << "Footprint was : " << footprintToString(ind.footprint);
-                output << endl;
-                std::cout << output.str();
-            }
-            ind.fitnesses["novelty"] = avgD;
-        }
-        archive.resize(savedArchiveSize);
-        archive.insert(std::end(archive), std::begin(toBeAdded), std::end(toBeAdded));
-        if (verbosity >= 2) {
-            std::stringstream output;
-            output << " Added " << toBeAdded.size() << " new footprints to the archive."
-                << std::endl
-                << "New archive size = " << archive.size() << " (was " << savedArchiveSize
-                << ")." << std::endl;
-            std::cout << output.str() << std::endl;
+                output << " Added " << added.size() << " new footprints to the archive."
+                    << std::endl
+                    << "New archive size = " << archive.size() << " (was " << savedArchiveSize
+                    << ")." << std::endl;
+                std::cout << output.str() << std::endl;
+            }
+            if (verbosity >= 2) {
+                std::stringstream output;
+                output << "Most novel individual (novelty = " << best.second
+                    << "): " << population[best.first].infos << endl;
+                cout << output.str();
+            }
         }
-        if (verbosity >= 2) {
-            std::stringstream output;
-            output << "Most novel individual (novelty = " << best.second
-                << "): " << best.first->infos << endl;
-            cout << output.str();
+
+        // new archive entries are dealt round robin to the shards
+#ifdef CLUSTER
+        if (nbRanks > 1) {
+            uint64_t nbAdded = added.size();
+            MPI_Bcast(&nbAdded, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+            added.resize(nbAdded);
+            MPI_Bcast(added.data(), static_cast<int>(nbAdded), MPI_UINT64_T, 0, MPI_COMM_WORLD);
+        }
+#endif
+        for (auto i : added) {
+            if (archiveCount % nbRanks == rank) {
+                const double *fp = popFp.data() + i * dim;
+                archiveShard.insert(archiveShard.end(), fp, fp + dim);
+            }
+            ++archiveCount;
         }
     }
 
@@ -1242,11 +4854,12 @@ template <typename DNA> class GA {
 #endif
 
     void updateStats(double totalTime) {
+        GAGA_TRACE_SPAN("stats");
         // stats organisations :
         // "global" -> {"genTotalTime", "indTotalTime", "maxTime", "nEvals", "nObjs"}
         // "obj_i" -> {"avg", "worst", "best"}
         assert(population.size());
-        std::map<std::string, std::map<std::string, double>> currentGenStats;
+        GenStats currentGenStats;
         currentGenStats["global"]["genTotalTime"] = totalTime;
         double indTotalTime = 0.0, maxTime = 0.0;
         int nEvals = 0;
@@ -1272,7 +4885,8 @@ template <typename DNA> class GA {
         currentGenStats["global"]["maxTime"] = maxTime;
         currentGenStats["global"]["nEvals"] = nEvals;
         currentGenStats["global"]["nObjs"] = nObjs;
-        genStats.push_back(currentGenStats);
+        if (genStats.endIndex() != currentGeneration) genStats.reset(currentGeneration);
+        genStats.push_back(std::move(currentGenStats));
     }
 
 #if not defined(NO_FANCY_OUTPUT)
@@ -1280,7 +4894,7 @@ template <typename DNA> class GA {
         const size_t l = 80;
         std::cout << tableHeader(l);
         std::ostringstream output;
-        const auto &globalStats = genStats[n].at("global");
+        const auto &globalStats = genStats.at(n).at("global");
         output << "Generation " << CYANBOLD << n << NORMAL << " ended in " << BLUE
             << globalStats.at("genTotalTime") << NORMAL << "s";
         std::cout << tableCenteredText(l, output.str(), BLUEBOLD NORMAL BLUE NORMAL);
@@ -1298,7 +4912,7 @@ template <typename DNA> class GA {
             << "s (x" << timeRatio << " ratio)";
         std::cout << tableCenteredText(l, output.str(), CYANBOLD NORMAL BLUE NORMAL "      ");
         std::cout << tableSeparation(l);
-        for (const auto &o : genStats[n]) {
+        for (const auto &o : genStats.at(n)) {
             if (o.first != "global") {
                 output = std::ostringstream();
                 output << GREYBOLD << "--◇" << GREENBOLD << std::setw(10) << o.first << GREYBOLD
@@ -1316,7 +4930,7 @@ template <typename DNA> class GA {
 #else
     void printGenStats(size_t n)
     {
-        const auto &globalStats = genStats[n].at("global");
+        const auto &globalStats = genStats.at(n).at("global");
 
         printf("Generation %s%zu%s ended in %s%.4fs%s (%.0f evaluations, %.0f objectives)\n", CYANBOLD, n, NORMAL, BLUE, globalStats.at("genTotalTime"), NORMAL, globalStats.at("nEvals"), globalStats.at("nObjs"));
 
@@ -1327,7 +4941,7 @@ template <typename DNA> class GA {
         printf("    - timings : max %s%.3fs%s, sum %s%.3fs%s (x%.3f ratio)\n", BLUE, globalStats.at("maxTime"), NORMAL, BLUEBOLD, globalStats.at("indTotalTime"), NORMAL, timeRatio);
         printf("    - fitnesses :\n");
 
-        for (const auto &o : genStats[n])
+        for (const auto &o : genStats.at(n))
         {
             if (o.first != "global")
             {
@@ -1401,254 +5015,163 @@ template <typename DNA> class GA {
     /*********************************************************************************
      *                         SAVING STUFF
      ********************************************************************************/
+    // Writes each (file name, dna) of files in dir, from the I/O thread
+    void saveDNAFiles(const string &dir, vector<std::pair<string, DNA>> &&files) {
+        if (verbosity >= 3) cerr << "saving " << files.size() << " dnas in " << dir << endl;
+        auto snapshot = std::make_shared<vector<std::pair<string, DNA>>>(std::move(files));
+        asyncWriter.submit([dir, snapshot]() {
+            fs::create_directory(dir);
+            for (const auto &f : *snapshot) {
+                std::ofstream fs(dir + "/" + f.first);
+                if (!fs) {
+                    cerr << "Cannot open the output file." << endl;
+                }
+                fs << f.second.serialize();
+                fs.close();
+            }
+        });
+    }
+
+    string genFolder() const {
+        std::stringstream baseName;
+        baseName << folder << "/gen" << currentGeneration;
+        return baseName.str();
+    }
+
     void saveBests(size_t n) {
-        if (n > 0) {
+        GAGA_TRACE_SPAN("saveBests");
+        if (n > 0 && selecMethod != SelectionMethod::nsga2Tournament) {
             // save n bests dnas for all objectives
-            vector<string> objectives;
-            for (auto &o : population[0].fitnesses) {
-                objectives.push_back(o.first);  // we need to know objective functions
-            }
-            auto elites = getElites(objectives, n, population);
-            std::stringstream baseName;
-            baseName << folder << "/gen" << currentGeneration;
-            fs::create_directory(baseName.str());
-            if (verbosity >= 3) {
-                cerr << "created directory " << baseName.str() << endl;
+            const EliteSet &elites = getEliteIndices(n);
+            if (runLogEnabled) {
+                for (size_t o = 0; o < elites.objectives.size(); ++o) {
+                    vector<Individual<DNA>> bests;
+                    for (size_t k = 0; k < n && k < elites.size(o); ++k)
+                        bests.push_back(population[elites.rows[o][k]]);
+                    logIndividuals(RunLogKind::elites, elites.objectives[o], std::move(bests));
+                }
+                return;
             }
-            for (auto &e : elites) {
-                int id = 0;
-                for (auto &i : e.second) {
+            vector<std::pair<string, DNA>> files;
+            for (size_t o = 0; o < elites.objectives.size(); ++o) {
+                const string &obj = elites.objectives[o];
+                for (size_t k = 0; k < n && k < elites.size(o); ++k) {
+                    const auto &i = population[elites.rows[o][k]];
                     std::stringstream fileName;
-                    fileName << baseName.str() << "/" << e.first << "_" << i.fitnesses.at(e.first)
-                        << "_" << id++ << ".dna";
-                    std::ofstream fs(fileName.str());
-                    if (!fs) {
-                        cerr << "Cannot open the output file." << endl;
-                    }
-                    fs << i.dna.serialize();
-                    fs.close();
+                    fileName << obj << "_" << i.fitnesses.at(obj) << "_" << k << ".dna";
+                    files.emplace_back(fileName.str(), i.dna);
                 }
             }
+            saveDNAFiles(genFolder(), std::move(files));
         }
     }
 
-    void nsga2SaveFront()
-    {
-        // FIXME(charly): This is temporary and sucks hard, needs to be moved to folder
-        std::string paretoFolder = "paretos";
-
-        if (currentGeneration == 0)
-        {
-            try
-            {
-                fs::remove_all(paretoFolder);
+    // Copies the objectives of the individuals of the first nbSavedFronts fronts of pop,
+    // which the I/O thread hands to the front sink. By default, each front is written in
+    // paretos/pareto_<generation>_<front>.dat in the run's folder: a "# objectives" line,
+    // then the objectives of one individual per line.
+    void saveFronts(const std::vector<Individual<DNA>> &pop, const ParetoRanking &ranking) {
+        GAGA_TRACE_SPAN("saveFronts");
+        vector<const Individual<DNA> *> rows;
+        vector<vector<uint32_t>> fronts;
+        for (size_t f = 0; f < ranking.fronts.size() && f < nbSavedFronts; ++f) {
+            fronts.emplace_back();
+            for (auto i : ranking.fronts[f]) {
+                fronts.back().push_back(static_cast<uint32_t>(rows.size()));
+                rows.push_back(&pop[i]);
             }
-            catch(std::exception& e) {}
-            fs::create_directory(paretoFolder);
         }
-
-        for (size_t i = 0; i < paretoFronts.size(); ++i)
-        {
-            std::string filename = paretoFolder + "/pareto_" + std::to_string(currentGeneration) + "_" + std::to_string(i) + ".dat";
-            std::ofstream file(filename);
-
-            for (auto ind : paretoFronts[i])
-            {
-                file << ind->fitnesses["f0"] << " " << ind->fitnesses["f1"] << "\n";
+        asyncWriter.submit([sink = frontSink, dir = folder + "/paretos", gen = currentGeneration,
+                            obj = ObjectiveMatrix(rows), fronts = std::move(fronts)]() {
+            if (sink) {
+                sink(gen, obj, fronts);
+                return;
             }
-
-            file.close();
-        }
+            fs::create_directory(dir);
+            for (size_t f = 0; f < fronts.size(); ++f) {
+                std::ofstream file(dir + "/pareto_" + std::to_string(gen) + "_" +
+                                   std::to_string(f) + ".dat");
+                file << "#";
+                for (const auto &name : obj.names) file << " " << name;
+                file << "\n";
+                for (auto r : fronts[f]) {
+                    for (size_t o = 0; o < obj.nbObjectives(); ++o)
+                        file << (o ? " " : "") << obj(r, o);
+                    file << "\n";
+                }
+                if (!file) cerr << "Cannot write the fronts in " << dir << endl;
+            }
+        });
     }
 
     void saveParetoFront() {
-        std::vector<Individual<DNA> *> pop;
-        for (size_t i = 0; i < population.size(); ++i) {
-            pop.push_back(&population[i]);
-        }
-
-        auto pfront = getParetoFront(pop);
-        std::stringstream baseName;
-        baseName << folder << "/gen" << currentGeneration;
-        fs::create_directory(baseName.str());
-        if (verbosity >= 3) {
-            std::cout << "created directory " << baseName.str() << std::endl;
+        GAGA_TRACE_SPAN("saveParetoFront");
+        auto onFront = getParetoFrontMembership(population);
+        if (runLogEnabled) {
+            vector<Individual<DNA>> front;
+            for (size_t i = 0; i < population.size(); ++i)
+                if (onFront[i]) front.push_back(population[i]);
+            logIndividuals(RunLogKind::paretoFront, "", std::move(front));
+            return;
         }
-
+        vector<std::pair<string, DNA>> files;
         int id = 0;
-        for (const auto &ind : pfront) {
+        for (size_t i = 0; i < population.size(); ++i) {
+            if (!onFront[i]) continue;
+            const auto &ind = population[i];
             std::stringstream filename;
-            filename << baseName.str() << "/";
-            for (const auto &f : ind->fitnesses) {
+            for (const auto &f : ind.fitnesses) {
                 filename << f.first << f.second << "_";
             }
             filename << id++ << ".dna";
-
-            std::ofstream fs(filename.str());
-            if (!fs) {
-                std::cerr << "Cannot open the output file.\n";
-            }
-            fs << ind->dna.serialize();
-            fs.close();
+            files.emplace_back(filename.str(), ind.dna);
         }
+        saveDNAFiles(genFolder(), std::move(files));
+    }
+
+    // appends individuals (best first for elites) to the run log, from the I/O thread
+    void logIndividuals(RunLogKind kind, const string &objective,
+                        vector<Individual<DNA>> &&inds) {
+        auto snapshot = std::make_shared<const vector<Individual<DNA>>>(std::move(inds));
+        asyncWriter.submit([this, kind, objective, snapshot, dir = folder, append = resumed,
+                            from = resumedGeneration, ev = evaluatorName,
+                            gen = currentGeneration]() {
+            if (!runLog.isOpen()) runLog.open(dir, append, from);
+            std::ostringstream record;
+            PopulationFile::write(record, *snapshot, ev, static_cast<int64_t>(gen));
+            runLog.append(gen, kind, objective, record.str());
+        });
     }
 
+    // appends the current generation's stats to gen_stats.csv
     void saveGenStats() {
-        std::stringstream csv;
-        std::stringstream fileName;
-        fileName << folder << "/gen_stats.csv";
-        csv << "generation";
-        if (genStats.size() > 0) {
-            for (const auto &cat : genStats[0]) {
-                std::stringstream column;
-                column << cat.first << "_";
-                for (const auto &s : cat.second) {
-                    csv << "," << column.str() << s.first;
-                }
-            }
-            csv << endl;
-            for (size_t i = 0; i < genStats.size(); ++i) {
-                csv << i;
-                for (const auto &cat : genStats[i]) {
-                    for (const auto &s : cat.second) {
-                        csv << "," << s.second;
-                    }
-                }
-                csv << endl;
-            }
-        }
-        std::ofstream fs(fileName.str());
-        if (!fs) cerr << "Cannot open the output file." << endl;
-        fs << csv.str();
-        fs.close();
+        GAGA_TRACE_SPAN("saveGenStats");
+        asyncWriter.submit([this, path = folder + "/gen_stats.csv", gen = currentGeneration,
+                            stats = genStats.back(), append = resumed,
+                            from = resumedGeneration]() {
+            if (!genStatsWriter.isOpen()) genStatsWriter.open(path, append, from);
+            genStatsWriter.write(gen, stats);
+        });
     }
 
-    // gen, idInd, fit0, fit1, time
+    // appends the fitnesses, Pareto front membership and evaluation time of each individual
+    // to ind_stats.bin (see IndStatsWriter)
     void saveIndStats() {
-        std::stringstream csv;
-        std::stringstream fileName;
-        fileName << folder << "/ind_stats.csv";
-
-        static bool indStatsWritten = false;
-
-        if (!indStatsWritten) {
-            csv << "generation,idInd,";
-            for (auto &o : population[0].fitnesses) csv << o.first << ",";
-            csv << "isOnParetoFront,time" << std::endl;
-            indStatsWritten = true;
-        }
-
-        std::vector<int> isOnParetoFront(population.size(), false);
+        GAGA_TRACE_SPAN("saveIndStats");
+        std::vector<bool> isOnParetoFront(population.size(), false);
         if (selecMethod == SelectionMethod::paretoTournament)
-        {
-            std::vector<Individual<DNA>*> pop;
-            for (auto &p : population) {
-                pop.push_back(&p);
-            }
-
-            auto front = getParetoFront(pop);
-
-            for (size_t i = 0; i < pop.size(); ++i) {
-                Individual<DNA> *ind0 = pop[i];
-                int found = 0;
-
-                for (size_t j = 0; !found && (j < front.size()); ++j) {
-                    Individual<DNA> *ind1 = front[j];
-
-                    if (ind1 == ind0) {
-                        found = 1;
-                    }
-                }
-
-                isOnParetoFront[i] = found;
-            }
-        }
-
-        for (size_t i = 0; i < population.size(); ++i) {
-            const auto &p = population[i];
-            csv << currentGeneration << "," << i << ",";
-            for (auto &o : p.fitnesses) csv << o.second << ",";
-            csv << isOnParetoFront[i] << "," << p.evalTime << std::endl;
-        }
-        std::ofstream fs;
-        fs.open(fileName.str(), std::fstream::out | std::fstream::app);
-        if (!fs) cerr << "Cannot open the output file." << endl;
-        fs << csv.str();
-        fs.close();
-    }
-
-    void saveIndStats_OneLinePerGen() {
-        std::stringstream csv;
-        std::stringstream fileName;
-        fileName << folder << "/ind_stats.csv";
-
-        static bool has_been_written = false;
-
-        if (!has_been_written) {
-            csv << "generation";
-            size_t i = 0;
-            for (const auto &ind : population) {
-                csv << ",ind" << i++;
-                for (const auto &f : ind.fitnesses) {
-                    csv << "," << f.first;
-                }
-                csv << ",is_on_pareto_front,eval_time";
-            }
-            csv << endl;
-
-            has_been_written = true;
-        }
-
-        std::vector<int> is_on_front(population.size(), false);
-
-        if (selecMethod == SelectionMethod::paretoTournament) {
-            std::vector<Individual<DNA> *> pop;
-
-            for (auto &p : population) {
-                pop.push_back(&p);
-            }
-
-            auto front = getParetoFront(pop);
-
-            for (size_t i = 0; i < pop.size(); ++i) {
-                Individual<DNA> *ind0 = pop[i];
-                int found = 0;
-
-                for (size_t j = 0; !found && (j < front.size()); ++j) {
-                    Individual<DNA> *ind1 = front[j];
-
-                    if (ind1 == ind0) {
-                        found = 1;
-                    }
-                }
-
-                is_on_front[i] = found;
-            }
-        }
-
-        {
-            csv << currentGeneration;
-            size_t ind_id = 0;
-            for (const auto &ind : population) {
-                csv << "," << ind_id;
-                for (const auto &f : ind.fitnesses) {
-                    csv << "," << f.second;
-                }
-
-                csv << "," << is_on_front[ind_id];
-                csv << "," << ind.evalTime;
-                ++ind_id;
-            }
-            csv << endl;
-        }
-
-        std::ofstream fs;
-        fs.open(fileName.str(), std::fstream::out | std::fstream::app);
-        if (!fs) {
-            cerr << "Cannot open the output file." << endl;
-        }
-        fs << csv.str();
-        fs.close();
+            isOnParetoFront = getParetoFrontMembership(population);
+
+        vector<double> evalTimes;
+        evalTimes.reserve(population.size());
+        for (const auto &p : population) evalTimes.push_back(p.evalTime);
+        asyncWriter.submit([this, path = folder + "/ind_stats.bin", gen = currentGeneration,
+                            obj = ObjectiveMatrix(population), onFront = std::move(isOnParetoFront),
+                            times = std::move(evalTimes), append = resumed,
+                            from = resumedGeneration]() {
+            if (!indStatsWriter.isOpen()) indStatsWriter.open(path, append, from);
+            indStatsWriter.write(gen, obj, onFront, times);
+        });
     }
 
     void createFolder(string baseFolder) {
@@ -1673,50 +5196,269 @@ template <typename DNA> class GA {
     }
 
  public:
+    // loads a population save, either binary or json
     void loadPop(string file) {
+        population.clear();
+        elitesCached = false;
+        if (PopulationFile::isPopulationFile(file)) {
+            PopulationFile pf(file);
+            currentGeneration = pf.hasGeneration() ? pf.generation() : 0;
+            for (size_t i = 0; i < pf.size(); ++i) population.emplace_back(DNA(pf.dna(i)));
+            return;
+        }
         std::ifstream t(file);
-        std::stringstream buffer;
-        buffer << t.rdbuf();
-        auto o = json::parse(buffer.str());
-        assert(o.count("population"));
+        auto o = readPopulationJSON(t, [&](const json &ind) {
+            const auto &d = ind.at("dna");
+            population.emplace_back(DNA(d.is_string() ? d.get<string>() : d.dump()));
+        });
         if (o.count("generation")) {
             currentGeneration = o.at("generation");
         } else {
             currentGeneration = 0;
         }
-        population.clear();
-        for (auto ind : o.at("population")) {
-            population.push_back(Individual<DNA>(DNA(ind.at("dna"))));
-            population[population.size() - 1].evaluated = false;
-        }
     }
 
     void savePop() {
-        json o = Individual<DNA>::popToJSON(population);
-        o["evaluator"] = evaluatorName;
-        o["generation"] = currentGeneration;
-        std::stringstream baseName;
-        baseName << folder << "/gen" << currentGeneration;
-        fs::create_directory(baseName.str());
+        GAGA_TRACE_SPAN("savePop");
+        if (runLogEnabled) {
+            logIndividuals(RunLogKind::population, "", vector<Individual<DNA>>(population));
+            return;
+        }
         std::stringstream fileName;
-        fileName << baseName.str() << "/pop" << currentGeneration << ".pop";
-        std::ofstream file;
-        file.open(fileName.str());
-        file << o.dump();
-        file.close();
+        fileName << "pop" << currentGeneration << popExtension();
+        savePopulationFile(population, fileName.str(), true);
     }
     void saveArchive() {
-        json o = Individual<DNA>::popToJSON(archive);
-        o["evaluator"] = evaluatorName;
-        std::stringstream baseName;
-        baseName << folder << "/gen" << currentGeneration;
-        fs::create_directory(baseName.str());
+        GAGA_TRACE_SPAN("saveArchive");
+        if (runLogEnabled) {
+            logIndividuals(RunLogKind::archive, "", vector<Individual<DNA>>(archive));
+            return;
+        }
         std::stringstream fileName;
-        fileName << baseName.str() << "/archive" << currentGeneration << ".pop";
-        std::ofstream file;
-        file.open(fileName.str());
-        file << o.dump();
-        file.close();
+        fileName << "archive" << currentGeneration << popExtension();
+        savePopulationFile(archive, fileName.str(), false);
+    }
+    const char *popExtension() const {
+        return popFormat == PopulationFormat::JSON ? ".pop" : ".gpop";
+    }
+    // copies pop, which is serialized and written by the I/O thread
+    void savePopulationFile(const vector<Individual<DNA>> &pop, const string &fileName,
+                            bool withGeneration) {
+        auto snapshot = std::make_shared<const vector<Individual<DNA>>>(pop);
+        asyncWriter.submit([this, snapshot, dir = genFolder(), fileName, withGeneration,
+                            ev = evaluatorName, gen = currentGeneration, format = popFormat,
+                            storePath = folder + "/dna.pack"]() {
+            fs::create_directory(dir);
+            if (format != PopulationFormat::JSON) {
+                DNAStore *store = nullptr;
+                if (format == PopulationFormat::incremental) {
+                    if (!dnaStore.isOpen() || dnaStore.path() != storePath)
+                        dnaStore.open(storePath);
+                    store = &dnaStore;
+                }
+                PopulationFile::write(dir + "/" + fileName, *snapshot, ev,
+                                      withGeneration ? static_cast<int64_t>(gen) : -1, store,
+                                      "../dna.pack");
+                return;
+            }
+            json header = {{"evaluator", ev}};
+            if (withGeneration) header["generation"] = gen;
+            std::ofstream file;
+            file.open(dir + "/" + fileName);
+            Individual<DNA>::popToJSON(file, *snapshot, header);
+            file.close();
+        });
+    }
+
+    /*********************************************************************************
+     *                                 CHECKPOINTS
+     ********************************************************************************/
+    // A checkpoint holds the whole state of the run between two generations: settings (see
+    // forEachCheckpointSetting, plus the run log, saved fronts and ind stats compression),
+    // population with fitnesses and footprints, previous generation, novelty archive,
+    // NSGA-II ranking, stats history, random streams and generation number. Not restored:
+    // the functions (evaluator, isBetter, custom selection policies, front sink...), async
+    // saving, parallel breeding, fitness recycling and the distributed evaluation settings.
+    // The file is written next to its final path then renamed, so a crash never leaves a
+    // partial checkpoint: if it can't be written, the save throws (see waitForSaves).
+    // Resuming from it continues the run exactly as if it had never stopped. With MPI,
+    // every rank must call resumeFromCheckpoint (only the master reads the file).
+    static constexpr uint32_t checkpointVersion = 2;
+    static const char *checkpointMagic() { return "GAGACKP"; }  // with its trailing '\0'
+
+    void saveCheckpoint(const string &path) {
+        GAGA_TRACE_SPAN("saveCheckpoint");
+        if (procId != 0) return;
+        string out(checkpointMagic(), 8);
+        binaryPut(out, uint32_t(checkpointVersion));
+        binaryPut(out, uint32_t(PopulationFile::byteOrderMark));
+        binaryPut(out, currentGeneration);
+        binaryPut(out, evalRound);
+        binaryPut(out, randomStreams.toJSON().dump());
+        forEachCheckpointSetting([&](const auto &v) { binaryPut(out, v); });
+        binaryPut(out, runLogEnabled);  // since version 2
+        binaryPut(out, nbSavedFronts);
+        binaryPut(out, indStatsWriter.isCompressed());
+        binaryPut(out, runLog.getSegmentSize());
+        for (const auto *pop : {&population, &lastGen, &archive}) {
+            binaryPut(out, static_cast<uint64_t>(pop->size()));
+            for (const auto &ind : *pop) ind.toBinary(out);
+        }
+        binaryPut(out, static_cast<uint64_t>(paretoRanking.size()));
+        for (size_t i = 0; i < paretoRanking.size(); ++i) {
+            binaryPut(out, paretoRanking.rank[i]);
+            binaryPut(out, paretoRanking.crowding[i]);
+        }
+        binaryPut(out, static_cast<uint64_t>(paretoRanking.fronts.size()));
+        for (const auto &f : paretoRanking.fronts) {
+            binaryPut(out, static_cast<uint64_t>(f.size()));
+            for (auto i : f) binaryPut(out, i);
+        }
+        binaryPut(out, genStats.capacity());
+        binaryPut(out, genStats.firstIndex());
+        binaryPut(out, static_cast<uint64_t>(genStats.size()));
+        for (size_t g = genStats.firstIndex(); g < genStats.endIndex(); ++g) {
+            binaryPut(out, static_cast<uint64_t>(genStats[g].size()));
+            for (const auto &cat : genStats[g]) {
+                binaryPut(out, cat.first);
+                binaryPut(out, static_cast<uint64_t>(cat.second.size()));
+                for (const auto &st : cat.second) {
+                    binaryPut(out, st.first);
+                    binaryPut(out, st.second);
+                }
+            }
+        }
+        auto data = std::make_shared<const string>(std::move(out));
+        asyncWriter.submit([data, path]() {
+            const string tmp = path + ".tmp";
+            std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+            file.write(data->data(), static_cast<std::streamsize>(data->size()));
+            file.close();
+            if (!file) throw std::runtime_error("Cannot write the checkpoint " + tmp);
+            std::error_code ec;
+            fs::rename(tmp, path, ec);
+            if (ec) throw std::runtime_error("Cannot move the checkpoint to " + path);
+        });
+    }
+
+    void resumeFromCheckpoint(const string &path) {
+        asyncWriter.drain();
+        string data;
+        if (procId == 0) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) throw std::runtime_error("Cannot open the checkpoint " + path);
+            data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+#ifdef CLUSTER
+        uint64_t size = data.size();
+        MPI_Bcast(&size, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+        data.resize(size);
+        MPI_Bcast(&data[0], static_cast<int>(size), MPI_CHAR, 0, MPI_COMM_WORLD);
+#endif
+        const char *cur = data.data(), *end = data.data() + data.size();
+        if (data.size() < 16 || !std::equal(cur, cur + 8, checkpointMagic()))
+            throw std::runtime_error(path + " is not a checkpoint");
+        cur += 8;
+        const auto version = binaryGet<uint32_t>(cur, end);
+        if (version > checkpointVersion)
+            throw std::runtime_error(path + " was written by a newer version of gaga");
+        if (binaryGet<uint32_t>(cur, end) != PopulationFile::byteOrderMark)
+            throw std::runtime_error(path + " was written with another byte order");
+        binaryRead(cur, end, currentGeneration);
+        binaryRead(cur, end, evalRound);
+        randomStreams.fromJSON(json::parse(binaryGetString(cur, end)));
+        const auto previousMethod = selecMethod;  // keeps custom policies
+        forEachCheckpointSetting([&](auto &v) { binaryRead(cur, end, v); });
+        if (selecMethod != previousMethod) setSelectionMethod(selecMethod);
+        if (version >= 2) {
+            binaryRead(cur, end, runLogEnabled);
+            binaryRead(cur, end, nbSavedFronts);
+            setIndStatsCompression(binaryGet<bool>(cur, end));
+            setRunLogSegmentSize(binaryGet<uint64_t>(cur, end));
+        }
+        for (auto *pop : {&population, &lastGen, &archive}) {
+            pop->clear();
+            auto n = binaryGet<uint64_t>(cur, end);
+            for (uint64_t i = 0; i < n; ++i) pop->push_back(Individual<DNA>::fromBinary(cur, end));
+        }
+        paretoRanking = ParetoRanking();
+        auto n = binaryGet<uint64_t>(cur, end);
+        for (uint64_t i = 0; i < n; ++i) {
+            paretoRanking.rank.push_back(binaryGet<int>(cur, end));
+            paretoRanking.crowding.push_back(binaryGet<double>(cur, end));
+        }
+        paretoRanking.fronts.resize(binaryGet<uint64_t>(cur, end));
+        for (auto &f : paretoRanking.fronts) {
+            f.resize(binaryGet<uint64_t>(cur, end));
+            for (auto &i : f) i = binaryGet<uint32_t>(cur, end);
+        }
+        genStats.setCapacity(binaryGet<size_t>(cur, end));
+        genStats.reset(binaryGet<size_t>(cur, end));
+        n = binaryGet<uint64_t>(cur, end);
+        for (uint64_t g = 0; g < n; ++g) {
+            GenStats stats;
+            auto nbCats = binaryGet<uint64_t>(cur, end);
+            for (uint64_t c = 0; c < nbCats; ++c) {
+                auto &cat = stats[binaryGetString(cur, end)];
+                auto nbStats = binaryGet<uint64_t>(cur, end);
+                for (uint64_t k = 0; k < nbStats; ++k) {
+                    auto name = binaryGetString(cur, end);
+                    cat[name] = binaryGet<double>(cur, end);
+                }
+            }
+            genStats.push_back(std::move(stats));
+        }
+
+        // every rank rebuilds its shard of the archive (see updateNovelty)
+        archiveShard.clear();
+        archiveCount = archive.size();
+        const size_t nbRanks = static_cast<size_t>(nbCollectiveRanks());
+        for (size_t a = static_cast<size_t>(procId); a < archive.size(); a += nbRanks)
+            flattenFootprint(archive[a].footprint, archiveShard);
+        if (procId != 0) {  // only the master holds individuals
+            population.clear();
+            lastGen.clear();
+            archive.clear();
+        }
+        elitesCached = false;
+        // the files are truncated to this generation when they are reopened
+        resumed = true;
+        resumedGeneration = currentGeneration;
+        genStatsWriter.close();
+        indStatsWriter.close();
+        runLog.close();
+    }
+
+ protected:
+    // settings restored by resumeFromCheckpoint, in file order
+    template <typename F> void forEachCheckpointSetting(F &&f) {
+        f(novelty);
+        f(popSize);
+        f(nbElites);
+        f(nbSavedElites);
+        f(tournamentSize);
+        f(minNoveltyForArchive);
+        f(KNN);
+        f(savePopEnabled);
+        f(saveArchiveEnabled);
+        f(popFormat);
+        f(savePopInterval);
+        f(saveGenInterval);
+        f(folder);
+        f(evaluatorName);
+        f(crossoverProba);
+        f(mutationProba);
+        f(evaluateAllIndividuals);
+        f(doSaveParetoFront);
+        f(doSaveGenStats);
+        f(doSaveIndStats);
+        f(selecMethod);
+        f(checkpointInterval);
+    }
+
+    void autoCheckpoint() {
+        if (checkpointInterval > 0 && currentGeneration % checkpointInterval == 0)
+            saveCheckpoint(folder + "/checkpoint");
     }
 };
 }  // namespace GAGA
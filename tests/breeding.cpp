@@ -0,0 +1,147 @@
+#include "../gaga.hpp"
+#include "dna.hpp"
+#include "catch/catch.hpp"
+
+namespace {
+// deterministic operators: all the randomness comes from the GA's streams
+struct VecDNA {
+	std::vector<double> w = std::vector<double>(20, 0.0);
+	VecDNA() {}
+	explicit VecDNA(const std::string &s) : w(20, std::stod(s)) {}
+	void mutate() {
+		for (auto &v : w) v = std::fmod(v * 1.37 + 0.11, 3.0);
+	}
+	VecDNA crossover(const VecDNA &o) {
+		VecDNA r;
+		for (size_t i = 0; i < w.size(); ++i) r.w[i] = i % 2 ? w[i] : o.w[i];
+		return r;
+	}
+	void crossover(const VecDNA &o, VecDNA &c0, VecDNA &c1) {
+		for (size_t i = 0; i < w.size(); ++i) {
+			c0.w[i] = i % 3 ? w[i] : o.w[i];
+			c1.w[i] = i % 3 ? o.w[i] : w[i];
+		}
+	}
+	void reset() {}
+	std::string serialize() const { return std::to_string(w[0]); }
+};
+
+// two children crossover that appends to the children it is given: it relies on them
+// being fresh (it doesn't opt into storage reuse with crossoverInto)
+struct AppendDNA {
+	std::vector<int> genes;
+	AppendDNA() {}
+	explicit AppendDNA(const std::string &) : genes(8, 0) {}
+	void mutate() {}
+	AppendDNA crossover(const AppendDNA &o) {
+		AppendDNA r, unused;
+		crossover(o, r, unused);
+		return r;
+	}
+	void crossover(const AppendDNA &o, AppendDNA &c0, AppendDNA &c1) {
+		const size_t half = genes.size() / 2;
+		c0.genes.insert(c0.genes.end(), genes.begin(), genes.begin() + half);
+		c0.genes.insert(c0.genes.end(), o.genes.begin() + half, o.genes.end());
+		c1.genes.insert(c1.genes.end(), o.genes.begin(), o.genes.begin() + half);
+		c1.genes.insert(c1.genes.end(), genes.begin() + half, genes.end());
+	}
+	void reset() {}
+	std::string serialize() const { return std::to_string(genes.size()); }
+};
+
+std::vector<std::vector<double>> run(GAGA::SelectionMethod sm, uint64_t seed,
+                                     bool fitnessRecycling = false) {
+	GAGA::GA<VecDNA> ga(0, nullptr);
+	quietGA(ga, "/tmp/gaga_breeding_test");
+	ga.setSelectionMethod(sm);
+	ga.setSeed(seed);
+	ga.enableParallelBreeding();
+	if (fitnessRecycling) ga.enableFitnessRecycling();
+	ga.setEvaluator([](auto &i) {
+		double x = 0;
+		for (auto v : i.dna.w) x += v;
+		i.fitnesses["f0"] = x;
+		i.fitnesses["f1"] = -std::abs(x - 20.0);
+	});
+	ga.setPopSize(40);
+	int k = 0;
+	ga.initPopulation([&]() {
+		VecDNA d;
+		for (auto &v : d.w) v = std::fmod(k++ * 0.173, 3.0);
+		return d;
+	});
+	ga.step(5);
+	std::vector<std::vector<double>> res;
+	for (auto &i : ga.population) res.push_back(i.dna.w);
+	return res;
+}
+}  // namespace
+
+TEST_CASE("Breeding only depends on the seed", "[breeding]") {
+	for (auto sm : {GAGA::SelectionMethod::paretoTournament, GAGA::SelectionMethod::randomObjTournament,
+	                GAGA::SelectionMethod::nsga2Tournament}) {
+		auto a = run(sm, 42);
+		REQUIRE(a.size() == 40);
+		REQUIRE(a == run(sm, 42));
+		REQUIRE(a != run(sm, 43));
+		REQUIRE(a == run(sm, 42, true));
+	}
+}
+
+TEST_CASE("Two children crossovers get fresh children", "[breeding]") {
+	GAGA::GA<AppendDNA> ga(0, nullptr);
+	quietGA(ga, "/tmp/gaga_breeding_test");
+	ga.setSelectionMethod(GAGA::SelectionMethod::nsga2Tournament);
+	ga.setCrossoverProba(1.0);
+	ga.setEvaluator([](auto &i) {
+		i.fitnesses["f0"] = static_cast<double>(i.dna.genes.size());
+		i.fitnesses["f1"] = -static_cast<double>(i.dna.genes.size());
+	});
+	ga.setPopSize(40);
+	ga.initPopulation([]() { return AppendDNA("8"); });
+	ga.step(6);
+	for (auto &i : ga.population) REQUIRE(i.dna.genes.size() == 8);
+}
+
+TEST_CASE("NSGA-II breeds any population size", "[breeding]") {
+	for (size_t size : {1, 2, 3, 5, 6, 7, 10}) {
+		GAGA::GA<VecDNA> ga(0, nullptr);
+		quietGA(ga, "/tmp/gaga_breeding_test");
+		ga.setSelectionMethod(GAGA::SelectionMethod::nsga2Tournament);
+		ga.setEvaluator([](auto &i) {
+			i.fitnesses["f0"] = i.dna.w[0];
+			i.fitnesses["f1"] = -i.dna.w[1];
+		});
+		ga.setPopSize(size);
+		ga.initPopulation([]() { return VecDNA(); });
+		ga.step(3);
+		REQUIRE(ga.population.size() == size);
+		for (auto &i : ga.population) REQUIRE(i.evaluated);
+	}
+}
+
+TEST_CASE("Recycled fitnesses only keep the entries set by the evaluator", "[breeding]") {
+	GAGA::GA<VecDNA> ga(0, nullptr);
+	quietGA(ga, "/tmp/gaga_breeding_test");
+	ga.setCrossoverProba(1.0);
+	ga.setEvaluateAllIndividuals(true);
+	ga.enableFitnessRecycling();
+	ga.setEvaluator([&](auto &i) {
+		i.fitnesses["f0"] = i.dna.w[0];
+		i.fitnesses["failed"] = std::numeric_limits<double>::quiet_NaN();  // e.g. a failed simulation
+		if (ga.getCurrentGeneration() == 0) i.fitnesses["first"] = 1.0;
+	});
+	ga.setPopSize(40);
+	int k = 0;
+	ga.initPopulation([&]() {
+		VecDNA d;
+		for (auto &v : d.w) v = std::fmod(k++ * 0.173, 3.0);
+		return d;
+	});
+	ga.step(3);
+	for (auto &i : ga.lastGen) {
+		REQUIRE(i.fitnesses.size() == 2);
+		REQUIRE(i.fitnesses.at("f0") == i.dna.w[0]);
+		REQUIRE(std::isnan(i.fitnesses.at("failed")));
+	}
+}
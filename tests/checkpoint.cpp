@@ -0,0 +1,132 @@
+#include <iomanip>
+#include "../gaga.hpp"
+#include "dna.hpp"
+#include "catch/catch.hpp"
+
+namespace {
+struct VecDNA {
+	std::vector<double> w = std::vector<double>(6, 0.0);
+	VecDNA() {}
+	explicit VecDNA(const std::string &s) : w(nlohmann::json::parse(s).get<std::vector<double>>()) {}
+	void mutate(GAGA::RandomEngine &rng) {
+		std::normal_distribution<double> d(0.0, 0.3);
+		for (auto &v : w) v += d(rng);
+	}
+	VecDNA crossover(const VecDNA &o, GAGA::RandomEngine &rng) {
+		VecDNA c0, c1;
+		crossover(o, c0, c1, rng);
+		return c0;
+	}
+	void crossover(const VecDNA &o, VecDNA &c0, VecDNA &c1, GAGA::RandomEngine &rng) {
+		std::bernoulli_distribution d(0.5);
+		for (size_t i = 0; i < w.size(); ++i) {
+			bool b = d(rng);
+			c0.w[i] = b ? w[i] : o.w[i];
+			c1.w[i] = b ? o.w[i] : w[i];
+		}
+	}
+	void reset() {}
+	// exact, unlike json's dump()
+	std::string serialize() const {
+		std::ostringstream s;
+		s << std::setprecision(17) << "[";
+		for (size_t i = 0; i < w.size(); ++i) s << (i ? "," : "") << w[i];
+		s << "]";
+		return s.str();
+	}
+};
+
+void setup(GAGA::GA<VecDNA> &ga, GAGA::SelectionMethod method, bool novelty) {
+	quietGA(ga, "/tmp/gaga_checkpoint_test");
+	ga.setSeed(42);
+	ga.setPopSize(40);
+	ga.setSelectionMethod(method);
+	if (novelty) {
+		ga.enableNovelty();
+		ga.setKNN(5);
+		ga.setMinNoveltyForArchive(0.5);
+	}
+	ga.setEvaluator([](auto &i) {
+		double a = 0, b = 0;
+		for (auto v : i.dna.w) {
+			a -= std::abs(v - 1.0);
+			b -= std::abs(v + 1.0);
+		}
+		i.fitnesses["a"] = a;
+		i.fitnesses["b"] = b;
+		i.footprint = {i.dna.w};
+	});
+}
+
+// fitnesses and dna of the population after 6 generations, with a checkpoint after
+// `stop` generations (0: no checkpoint)
+std::vector<std::string> run(GAGA::SelectionMethod method, bool novelty, int stop) {
+	const std::string path = "/tmp/gaga_checkpoint_test.ckpt";
+	std::unique_ptr<GAGA::GA<VecDNA>> ga(new GAGA::GA<VecDNA>(0, nullptr));
+	setup(*ga, method, novelty);
+	auto &rng = ga->getRandomStreams().engine();
+	ga->initPopulation([&]() {
+		VecDNA d;
+		d.mutate(rng);
+		return d;
+	});
+	if (stop > 0) {
+		ga->step(stop);
+		ga->saveCheckpoint(path);
+		ga->waitForSaves();
+		ga.reset(new GAGA::GA<VecDNA>(0, nullptr));
+		setup(*ga, GAGA::SelectionMethod::paretoTournament, false);
+		ga->setPopSize(10);  // settings are restored as well
+		ga->resumeFromCheckpoint(path);
+		REQUIRE(ga->getCurrentGeneration() == static_cast<size_t>(stop));
+	}
+	ga->step(6 - stop);
+	std::vector<std::string> res;
+	for (const auto &i : ga->population) res.push_back(i.toJSON().at("dna").dump() + nlohmann::json(i.fitnesses).dump());
+	res.push_back(nlohmann::json(ga->getGenStats().back().at("a")).dump());
+	return res;
+}
+}  // namespace
+
+TEST_CASE("A run resumed from a checkpoint goes on as if it had never stopped", "[checkpoint]") {
+	for (auto method : {GAGA::SelectionMethod::paretoTournament, GAGA::SelectionMethod::nsga2Tournament}) {
+		for (bool novelty : {false, true}) {
+			auto ref = run(method, novelty, 0);
+			REQUIRE(ref.size() == 41);
+			REQUIRE(run(method, novelty, 2) == ref);
+			REQUIRE(run(method, novelty, 5) == ref);
+		}
+	}
+}
+
+TEST_CASE("Only checkpoints can be resumed from", "[checkpoint]") {
+	GAGA::GA<VecDNA> ga(0, nullptr);
+	REQUIRE_THROWS_AS(ga.resumeFromCheckpoint("/tmp/gaga_no_such_checkpoint"), std::runtime_error);
+	std::ofstream("/tmp/gaga_not_a_checkpoint") << "{}";
+	REQUIRE_THROWS_AS(ga.resumeFromCheckpoint("/tmp/gaga_not_a_checkpoint"), std::runtime_error);
+}
+
+TEST_CASE("Checkpoints keep the save settings, and failing to write one throws", "[checkpoint]") {
+	const std::string path = "/tmp/gaga_checkpoint_settings.ckpt";
+	auto read = [](const std::string &p) {
+		std::ifstream f(p, std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+	};
+	{
+		GAGA::GA<VecDNA> ga(0, nullptr);
+		setup(ga, GAGA::SelectionMethod::nsga2Tournament, false);
+		ga.enableRunLog();
+		ga.setRunLogSegmentSize(1234);
+		ga.setNbSavedFronts(2);
+		ga.initPopulation([]() { return VecDNA(); });
+		ga.step(1);
+		ga.saveCheckpoint(path);
+		REQUIRE_THROWS_AS(ga.saveCheckpoint("/tmp/gaga_no_such_dir/checkpoint"), std::runtime_error);
+	}
+	// a checkpoint of the resumed run is the same file
+	GAGA::GA<VecDNA> ga(0, nullptr);
+	setup(ga, GAGA::SelectionMethod::paretoTournament, false);
+	ga.resumeFromCheckpoint(path);
+	ga.saveCheckpoint(path + "2");
+	REQUIRE(read(path + "2") == read(path));
+}
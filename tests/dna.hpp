@@ -1,31 +1,33 @@
 #ifndef DNA_HPP
 #define DNA_HPP
 #include <random>
+#include "../gaga.hpp"
 #include "../include/json.hpp"
 
 struct IntDNA {
 	int value = 0;
-  std::default_random_engine rndEngine;
-	std::uniform_int_distribution<int> distribution =
-    std::uniform_int_distribution<int>(0, 1000000);
 	IntDNA() {}
 	// A valid dna must be able to be constructed from a json string
 	explicit IntDNA(const std::string &js) {
 		auto o = nlohmann::json::parse(js);
 		value = o["value"];
 	}
-	// It must have a mutate method
-	void mutate() { value = distribution(rndEngine); }
+	// It must have a mutate method (the GA's random engine is passed if it takes one)
+	void mutate(GAGA::RandomEngine &rng) { value = std::uniform_int_distribution<int>(0, 1000000)(rng); }
 	// A crossover method
-	IntDNA crossover(const IntDNA &other) {
-		std::uniform_int_distribution<int> dist = std::uniform_int_distribution<int>(0, 1);
-		if (dist(rndEngine) == 0) return *this;
+	IntDNA crossover(const IntDNA &other, GAGA::RandomEngine &rng) {
+		if (std::uniform_int_distribution<int>(0, 1)(rng) == 0) return *this;
 		return other;
 	}
+	// and, for NSGA-II, a crossover giving two offspring
+	void crossover(const IntDNA &other, IntDNA &child0, IntDNA &child1, GAGA::RandomEngine &rng) {
+		child0 = crossover(other, rng);
+		child1 = child0.value == value ? other : *this;
+	}
 	// A reset method (just to cleanup things before a new evaluation)
 	void reset() {}
 	// And a method that returns a json string
-	std::string toJSON() const {
+	std::string serialize() const {
 		nlohmann::json o;
 		o["value"] = value;
 		return o.dump(2);
@@ -36,4 +38,24 @@ struct IntDNA {
 		return d;
 	}
 };
+
+// DNA without genes, for the tests that only look at what the GA does with individuals
+struct NullDNA {
+	NullDNA() {}
+	explicit NullDNA(const std::string &) {}
+	void mutate() {}
+	NullDNA crossover(const NullDNA &) { return *this; }
+	void crossover(const NullDNA &, NullDNA &, NullDNA &) {}
+	void reset() {}
+	std::string serialize() const { return ""; }
+};
+
+// Makes a GA print nothing, and save nothing in folder but what a test enables afterwards
+template <typename DNA> void quietGA(GAGA::GA<DNA> &ga, const std::string &folder) {
+	ga.setVerbosity(0);
+	ga.setSaveFolder(folder);
+	ga.disablePopulationSave();
+	ga.setSaveGenStats(false);
+	ga.setNbSavedElites(0);
+}
 #endif
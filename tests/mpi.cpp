@@ -0,0 +1,63 @@
+// built as gaga_mpi_test and run by ctest under mpiexec (see CMakeLists.txt): the MPI
+// runtime must let the job go on when a process dies (Open MPI's --enable-recovery)
+#define CLUSTER
+#include <signal.h>
+#include <unistd.h>
+#include "../gaga.hpp"
+#include "dna.hpp"
+#include "catch/catch.hpp"
+
+namespace {
+struct MPIDNA {
+	int value = 0;
+	MPIDNA() {}
+	explicit MPIDNA(const std::string &s) { value = std::stoi(s); }
+	void mutate() { value = (value * 7 + 3) % 1000; }
+	MPIDNA crossover(const MPIDNA &other) {
+		MPIDNA d;
+		d.value = (value + other.value) / 2;
+		return d;
+	}
+	void crossover(const MPIDNA &other, MPIDNA &child0, MPIDNA &child1) {
+		child0 = crossover(other);
+		child1 = child0;
+	}
+	void reset() {}
+	std::string serialize() const { return std::to_string(value); }
+};
+}  // namespace
+
+// MPI can only be initialized once per process: this is the only test case
+TEST_CASE("Resilient MPI evaluation survives the death of a worker rank", "[mpi]") {
+	GAGA::GA<MPIDNA> ga(0, nullptr);
+	int rank, nbRanks;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &nbRanks);
+	REQUIRE(nbRanks >= 3);
+	quietGA(ga, "/tmp");
+	ga.enableResilientEvaluation();
+	ga.setEvalBatchSize(4);
+	ga.setWorkerTimeout(2.0);
+	int nbEvals = 0;
+	ga.setEvaluator([&](auto &i) {
+		if (rank == nbRanks - 1 && ++nbEvals > 30) raise(SIGKILL);  // dies in generation 0
+		usleep(1000);
+		i.fitnesses["value"] = i.dna.value * 2;
+	});
+	ga.setPopSize(100);
+	int n = 0;
+	ga.initPopulation([&]() {
+		MPIDNA d;
+		d.value = n++;
+		return d;
+	});
+	ga.step(4);
+	if (rank == 0) {
+		REQUIRE(ga.lastGen.size() == 100);
+		for (auto &i : ga.lastGen) {
+			REQUIRE(i.evaluated);
+			REQUIRE(i.fitnesses.at("value") == i.dna.value * 2);
+		}
+	}
+	ga.finish();  // doesn't hang on the dead rank
+}
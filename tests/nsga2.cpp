@@ -8,21 +8,12 @@
 using RealDistribution = std::uniform_real_distribution<>;
 using IntDistribution  = std::uniform_int_distribution<int>;
 
-static std::random_device   rd;
-static std::mt19937_64      gen(rd());
-static RealDistribution     rdis(0.0, 1.0);
-static IntDistribution      idis(0, 1);
-
 struct TestDNA
 {
-    double v0;
-    double v1;
+    double v0 = 0.0;
+    double v1 = 0.0;
 
-    TestDNA()
-    {
-        v0 = rdis(gen);
-        v1 = rdis(gen);
-    }
+    TestDNA() {}
 
     explicit TestDNA(const std::string& js)
     {
@@ -31,22 +22,22 @@ struct TestDNA
         v1 = o["v1"];
     }
 
-    void mutate()
+    void mutate(GAGA::RandomEngine& rng)
     {
-        int v = idis(gen);
+        int v = IntDistribution(0, 1)(rng);
         if (v == 0)
         {
-            v0 = rdis(gen);
+            v0 = RealDistribution(0.0, 1.0)(rng);
         }
         else
         {
-            v1 = rdis(gen);
+            v1 = RealDistribution(0.0, 1.0)(rng);
         }
     }
 
-    void crossover(const TestDNA& other, TestDNA& child0, TestDNA& child1)
+    void crossover(const TestDNA& other, TestDNA& child0, TestDNA& child1, GAGA::RandomEngine& rng)
     {
-        int v = idis(gen);
+        int v = IntDistribution(0, 1)(rng);
         if (v == 0)
         {
             child0.v0 = v0;
@@ -65,11 +56,11 @@ struct TestDNA
         }
     }
 
-    TestDNA crossover(const TestDNA& other)
+    TestDNA crossover(const TestDNA& other, GAGA::RandomEngine& rng)
     {
         TestDNA result;
 
-        int v = idis(gen);
+        int v = IntDistribution(0, 1)(rng);
         if (v == 0)
         {
             result.v0 = v0;
@@ -96,9 +87,11 @@ struct TestDNA
         return o.dump(2);
     }
 
-    static TestDNA random()
+    static TestDNA random(GAGA::RandomEngine& rng)
     {
         TestDNA d;
+        d.v0 = RealDistribution(0.0, 1.0)(rng);
+        d.v1 = RealDistribution(0.0, 1.0)(rng);
         return d;
     }
 };
@@ -111,6 +104,7 @@ int main(int argc, char** argv)
     ga.setCrossoverProba(0.3);
     ga.setMutationProba(0.7);
     ga.setSelectionMethod(GAGA::SelectionMethod::nsga2Tournament);
+    ga.setNbSavedFronts(5);  // in evos/<run>/paretos, see plot.py
     ga.setIsBetterMethod([](auto a, auto b) { return a < b; });
     ga.setEvaluator([](auto& i)
                     {
@@ -125,7 +119,8 @@ int main(int argc, char** argv)
                     });
 
     ga.setPopSize(200);
-    ga.initPopulation([]() { return TestDNA::random(); });
+    auto& rng = ga.getRandomStreams().engine();
+    ga.initPopulation([&]() { return TestDNA::random(rng); });
     ga.step(1000);
 
     return 0;
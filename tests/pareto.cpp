@@ -14,3 +14,102 @@ template <typename T> void paretoGA() {
 	REQUIRE(ga.population.size() == 400);
 }
 TEST_CASE("Pareto multi-objective optimization", "[population]") { paretoGA<IntDNA>(); }
+
+// brute force check of the extractor, with many ties, for 1 to 4 objectives
+TEST_CASE("Pareto front extraction", "[pareto]") {
+	std::mt19937 rng(5);
+	std::function<bool(double, double)> greater = [](double a, double b) { return a > b; };
+	GAGA::ParetoFrontExtractor extractor;
+	std::vector<bool> onFront;
+	for (size_t nbObj = 1; nbObj <= 4; ++nbObj) {
+		for (int t = 0; t < 20; ++t) {
+			std::vector<GAGA::Individual<IntDNA>> pop(50);
+			for (auto &i : pop)
+				for (size_t o = 0; o < nbObj; ++o) i.fitnesses["o" + std::to_string(o)] = static_cast<double>(rng() % 6);
+			GAGA::ObjectiveMatrix obj(pop);
+			extractor.extract(obj, greater, onFront);
+			for (size_t i = 0; i < pop.size(); ++i) {
+				bool dominated = false;
+				for (size_t j = 0; j < pop.size(); ++j)
+					dominated = dominated || GAGA::ParetoFrontExtractor::dominates(obj, j, i, greater);
+				REQUIRE(onFront[i] == !dominated);
+			}
+		}
+	}
+}
+
+namespace {
+void frontsGA(GAGA::GA<IntDNA> &ga, const std::string &folder, size_t nbFronts) {
+	fs::remove_all(folder);
+	quietGA(ga, folder);
+	ga.setSelectionMethod(GAGA::SelectionMethod::nsga2Tournament);
+	ga.setNbSavedFronts(nbFronts);
+	ga.setEvaluator([](auto &i) {
+		i.fitnesses["a"] = i.dna.value % 10;
+		i.fitnesses["b"] = i.dna.value / 10 % 10;
+		i.fitnesses["c"] = 0;
+	});
+	ga.setPopSize(48);
+	int k = 0;
+	ga.initPopulation([&]() {
+		IntDNA d;
+		d.value = k++;
+		return d;
+	});
+}
+}  // namespace
+
+TEST_CASE("NSGA-II fronts are handed to the front sink", "[pareto]") {
+	GAGA::GA<IntDNA> ga(0, nullptr);
+	frontsGA(ga, "/tmp/gaga_fronts_test", 2);
+	ga.setGenSaveInterval(2);
+	std::vector<size_t> generations;
+	ga.setFrontSink([&](size_t gen, const GAGA::ObjectiveMatrix &obj,
+	                    const std::vector<std::vector<uint32_t>> &fronts) {
+		generations.push_back(gen);
+		REQUIRE(obj.names == std::vector<std::string>{"a", "b", "c"});
+		REQUIRE(fronts.size() == 2);
+		REQUIRE(fronts[0].size() + fronts[1].size() == obj.nbRows);
+		std::function<bool(double, double)> greater = [](double a, double b) { return a > b; };
+		// every row of the second front is dominated by a row of the first one
+		for (auto r : fronts[1]) {
+			bool dominated = false;
+			for (auto f : fronts[0])
+				dominated = dominated || GAGA::NSGA2Sorter::dominates(obj, f, r, greater) == 1;
+			REQUIRE(dominated);
+		}
+	});
+	ga.step(4);
+	ga.finish();
+	REQUIRE(generations == std::vector<size_t>{0, 2});
+}
+
+TEST_CASE("NSGA-II fronts are saved in the run's folder", "[pareto]") {
+	const std::string folder = "/tmp/gaga_fronts_test";
+	{
+		GAGA::GA<IntDNA> ga(0, nullptr);
+		frontsGA(ga, folder, 1);
+		ga.step(2);
+		ga.finish();
+	}
+	std::vector<fs::path> runs;
+	for (const auto &d : fs::directory_iterator(folder)) runs.push_back(d.path());
+	REQUIRE(runs.size() == 1);
+	const auto paretos = runs[0] / "paretos";
+	REQUIRE(fs::exists(paretos / "pareto_0_0.dat"));
+	REQUIRE(fs::exists(paretos / "pareto_1_0.dat"));
+	REQUIRE_FALSE(fs::exists(paretos / "pareto_0_1.dat"));
+	std::ifstream file((paretos / "pareto_1_0.dat").string());
+	std::string header, row;
+	std::getline(file, header);
+	std::getline(file, row);
+	REQUIRE(header == "# a b c");
+	REQUIRE(std::count(row.begin(), row.end(), ' ') == 2);
+	{
+		GAGA::GA<IntDNA> ga(0, nullptr);
+		frontsGA(ga, folder, 0);
+		ga.step(2);
+		ga.finish();
+	}
+	for (const auto &d : fs::directory_iterator(folder)) REQUIRE_FALSE(fs::exists(d.path() / "paretos"));
+}
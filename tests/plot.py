@@ -5,6 +5,7 @@ from matplotlib import pyplot as plt
 import fnmatch
 import os
 import re
+import sys
 
 current_gen = 0
 
@@ -25,10 +26,10 @@ def plot_generation(gen):
 
         if True:
             for file in generation_files[gen]:
-                x, y = np.loadtxt(file, delimiter=' ', unpack=True)
+                x, y = np.loadtxt(file, delimiter=' ', usecols=(0, 1), unpack=True, ndmin=2)
                 ax.plot(x, y, 'o')
         else:
-            x, y = np.loadtxt(generation_files[gen][0], unpack=True)
+            x, y = np.loadtxt(generation_files[gen][0], usecols=(0, 1), unpack=True, ndmin=2)
             ax.plot(x, y, 'o')
 
         plt.draw()
@@ -47,7 +48,10 @@ def on_key_event(event):
 
 fig.canvas.mpl_connect('key_release_event', on_key_event)
 
-for file in os.listdir('paretos'):
+# the paretos folder of a run (see GA::setNbSavedFronts)
+pareto_folder = sys.argv[1] if len(sys.argv) > 1 else 'paretos'
+
+for file in os.listdir(pareto_folder):
     match = re.search(r"pareto_([0-9]+)_([0-9]+).dat", file)
     if match:
         generation = int(match.group(1))
@@ -55,7 +59,7 @@ for file in os.listdir('paretos'):
 
         if not generation in generation_files:
             generation_files[generation] = []
-        generation_files[generation].append('paretos/' + file)
+        generation_files[generation].append(os.path.join(pareto_folder, file))
 
 for gen in generation_files:
     generation_files[gen].sort()
@@ -0,0 +1,144 @@
+#include "../gaga.hpp"
+#include "catch/catch.hpp"
+
+namespace {
+std::vector<GAGA::Individual<GAGA::RawDNA>> makePop() {
+	std::vector<GAGA::Individual<GAGA::RawDNA>> pop;
+	for (int i = 0; i < 5; ++i) {
+		GAGA::Individual<GAGA::RawDNA> ind(GAGA::RawDNA(std::string(static_cast<size_t>(i), 'x')));
+		ind.fitnesses = {{"a", i * 0.5}, {"b", -i}};
+		ind.footprint = {{1.0 * i, 2.0}, {3.0, 4.0}};
+		ind.infos = i % 2 ? "odd" : "";
+		ind.evaluated = true;
+		ind.wasAlreadyEvaluated = i == 3;
+		ind.evalTime = 0.25 * i;
+		pop.push_back(ind);
+	}
+	pop.emplace_back(GAGA::RawDNA("not evaluated"));
+	return pop;
+}
+
+// every DNA has the same hash
+struct CollidingHash {
+	uint64_t operator()(const char *, size_t) const { return 0; }
+};
+}  // namespace
+
+TEST_CASE("Population files give random access to the individuals", "[popfile]") {
+	const std::string path = "/tmp/gaga_popfile_test.gpop";
+	auto pop = makePop();
+	GAGA::PopulationFile::write(path, pop, "eval", 12);
+	REQUIRE(GAGA::PopulationFile::isPopulationFile(path));
+	GAGA::PopulationFile pf(path);
+	REQUIRE(pf.size() == pop.size());
+	REQUIRE(pf.generation() == 12);
+	REQUIRE(pf.evaluator() == "eval");
+	REQUIRE(pf.objectives() == std::vector<std::string>{"a", "b"});
+	REQUIRE(pf.fitness(3, 0) == 1.5);
+	REQUIRE(pf.dna(4) == "xxxx");
+	REQUIRE_FALSE(pf.isEvaluated(5));
+	REQUIRE_THROWS_AS(pf.dna(6), std::out_of_range);
+	for (size_t i = 0; i < pop.size(); ++i) REQUIRE(pf.individual<GAGA::RawDNA>(i).toJSON() == pop[i].toJSON());
+	// the json export is the same document as a json save
+	auto o = GAGA::Individual<GAGA::RawDNA>::popToJSON(pop);
+	o["evaluator"] = "eval";
+	o["generation"] = 12;
+	REQUIRE(pf.toJSON() == o);
+}
+
+TEST_CASE("Population files reject mixed objectives", "[popfile]") {
+	auto pop = makePop();
+	pop[2].fitnesses["c"] = 0.0;
+	REQUIRE_THROWS_AS(GAGA::PopulationFile::write("/tmp/gaga_popfile_test.gpop", pop), std::invalid_argument);
+	REQUIRE_THROWS_AS(GAGA::PopulationFile("/tmp"), std::runtime_error);
+}
+
+TEST_CASE("A GA loads binary and json population saves", "[popfile]") {
+	const std::string bin = "/tmp/gaga_popfile_test.gpop", txt = "/tmp/gaga_popfile_test.pop";
+	auto pop = makePop();
+	GAGA::PopulationFile::write(bin, pop, "eval", 7);
+	std::ofstream(txt) << GAGA::PopulationFile(bin).toJSON().dump();
+	for (const auto &path : {bin, txt}) {
+		GAGA::GA<GAGA::RawDNA> ga(0, nullptr);
+		ga.loadPop(path);
+		REQUIRE(ga.getCurrentGeneration() == 7);
+		REQUIRE(ga.population.size() == pop.size());
+		REQUIRE(ga.population[5].dna.str == "not evaluated");
+		REQUIRE_FALSE(ga.population[0].evaluated);
+	}
+}
+
+TEST_CASE("Incremental population files only store new DNAs", "[popfile]") {
+	const std::string dir = "/tmp/gaga_popfile_store";
+	fs::remove_all(dir);
+	fs::create_directories(dir + "/gen0");
+	fs::create_directories(dir + "/gen1");
+	auto pop = makePop();
+	GAGA::DNAStore store;
+	store.open(dir + "/dna.pack");
+	GAGA::PopulationFile::write(dir + "/gen0/pop0.gpop", pop, "eval", 0, &store, "../dna.pack");
+	REQUIRE(store.size() == pop.size());
+	const auto packSize = fs::file_size(dir + "/dna.pack");
+	// next generation: clones and a single new DNA
+	pop[0] = pop[3];
+	pop[1].dna.str = "new";
+	GAGA::PopulationFile::write(dir + "/gen1/pop1.gpop", pop, "eval", 1, &store, "../dna.pack");
+	REQUIRE(store.size() == 7);
+	REQUIRE(fs::file_size(dir + "/dna.pack") == packSize + 8 + 3);
+	GAGA::PopulationFile pf(dir + "/gen1/pop1.gpop");
+	for (size_t i = 0; i < pop.size(); ++i) REQUIRE(pf.individual<GAGA::RawDNA>(i).toJSON() == pop[i].toJSON());
+	REQUIRE(GAGA::PopulationFile(dir + "/gen0/pop0.gpop").dna(1) == "x");
+	// a reopened store knows its DNAs, and drops an interrupted write
+	store.close();
+	std::ofstream(dir + "/dna.pack", std::ios::app) << "partial";
+	store.open(dir + "/dna.pack");
+	REQUIRE(store.size() == 7);
+	REQUIRE(fs::file_size(dir + "/dna.pack") == packSize + 8 + 3);
+	REQUIRE(store.put("new") == GAGA::DNAStore::Ref(packSize + 8, 3));
+}
+
+TEST_CASE("DNAs whose hashes collide are stored apart", "[popfile]") {
+	const std::string path = "/tmp/gaga_popfile_collisions.pack";
+	fs::remove(path);
+	GAGA::BasicDNAStore<CollidingHash> store;
+	store.open(path);
+	auto a = store.put("aaa");
+	auto b = store.put("bbb");
+	REQUIRE(a != b);
+	REQUIRE(store.put("aaa") == a);
+	REQUIRE(store.put("bbb") == b);
+	REQUIRE(store.size() == 2);
+	// same for the DNAs a reopened store indexes
+	store.open(path);
+	REQUIRE(store.put("bbb") == b);
+	REQUIRE(store.put("ccc").first > b.first);
+	REQUIRE(store.put("aaa") == a);
+	REQUIRE(store.size() == 3);
+}
+
+TEST_CASE("Json populations are streamed one individual at a time", "[popfile]") {
+	auto pop = makePop();
+	std::stringstream s;
+	GAGA::Individual<GAGA::RawDNA>::popToJSON(s, pop, {{"evaluator", "eval"}, {"generation", 3}});
+	auto o = GAGA::Individual<GAGA::RawDNA>::popToJSON(pop);
+	o["evaluator"] = "eval";
+	o["generation"] = 3;
+	REQUIRE(nlohmann::json::parse(s.str()) == o);
+	nlohmann::json header;
+	auto back = GAGA::Individual<GAGA::RawDNA>::loadPopFromJSON(s, &header);
+	REQUIRE(header == nlohmann::json({{"evaluator", "eval"}, {"generation", 3}}));
+	REQUIRE(back.size() == pop.size());
+	for (size_t i = 0; i < pop.size(); ++i) REQUIRE(back[i].toJSON() == pop[i].toJSON());
+	// individuals are handed over as they are parsed: a truncated document still delivers
+	// its complete individuals before failing
+	std::string truncated = s.str().substr(0, s.str().size() / 2);
+	std::istringstream in(truncated);
+	size_t nb = 0;
+	REQUIRE_THROWS_AS(GAGA::readPopulationJSON(in, [&](const nlohmann::json &) { ++nb; }),
+	                  std::invalid_argument);
+	REQUIRE(nb > 0);
+	REQUIRE(nb < pop.size());
+	std::istringstream notPop("{\"individuals\": []}");
+	REQUIRE_THROWS_AS(GAGA::readPopulationJSON(notPop, [](const nlohmann::json &) {}),
+	                  std::invalid_argument);
+}
@@ -0,0 +1,83 @@
+#include "../gaga.hpp"
+#include "dna.hpp"
+#include "catch/catch.hpp"
+
+namespace {
+// operators that take the GA's random engine
+struct NoisyDNA {
+	std::vector<double> w = std::vector<double>(10, 0.0);
+	NoisyDNA() {}
+	explicit NoisyDNA(const std::string &s) : w(10, std::stod(s)) {}
+	void mutate(GAGA::RandomEngine &rng) {
+		std::normal_distribution<double> d(0.0, 0.1);
+		for (auto &v : w) v += d(rng);
+	}
+	NoisyDNA crossover(const NoisyDNA &o, GAGA::RandomEngine &rng) {
+		std::bernoulli_distribution d(0.5);
+		NoisyDNA r;
+		for (size_t i = 0; i < w.size(); ++i) r.w[i] = d(rng) ? w[i] : o.w[i];
+		return r;
+	}
+	void crossover(const NoisyDNA &o, NoisyDNA &c0, NoisyDNA &c1, GAGA::RandomEngine &rng) {
+		std::bernoulli_distribution d(0.5);
+		for (size_t i = 0; i < w.size(); ++i) {
+			bool b = d(rng);
+			c0.w[i] = b ? w[i] : o.w[i];
+			c1.w[i] = b ? o.w[i] : w[i];
+		}
+	}
+	void reset() {}
+	std::string serialize() const { return std::to_string(w[0]); }
+};
+
+std::vector<std::vector<double>> run(uint64_t seed) {
+	GAGA::GA<NoisyDNA> ga(0, nullptr);
+	quietGA(ga, "/tmp/gaga_random_test");
+	ga.setSeed(seed);
+	ga.enableParallelBreeding();
+	ga.setEvaluator([](auto &i) {
+		double x = 0;
+		for (auto v : i.dna.w) x -= std::abs(v - 1.0);
+		i.fitnesses["f"] = x;
+	});
+	ga.setPopSize(30);
+	auto &rng = ga.getRandomStreams().engine();
+	ga.initPopulation([&]() {
+		NoisyDNA d;
+		d.mutate(rng);
+		return d;
+	});
+	ga.step(5);
+	std::vector<std::vector<double>> res;
+	for (auto &i : ga.population) res.push_back(i.dna.w);
+	return res;
+}
+}  // namespace
+
+TEST_CASE("Random streams only depend on the seed and their coordinates", "[random]") {
+	GAGA::RandomStreams a(7), b(7), c(8);
+	REQUIRE(a.stream(3, 4)() == b.stream(3, 4)());
+	REQUIRE(a.stream(3, 4)() != a.stream(4, 3)());
+	REQUIRE(a.stream(3, 4)() != c.stream(3, 4)());
+	REQUIRE(a.threadStream(0) != a.threadStream(1));
+	auto e = a.engine();
+	e.jump();
+	REQUIRE(e == a.threadStream(0));
+}
+
+TEST_CASE("Random streams can be saved and restored", "[random]") {
+	GAGA::RandomStreams a(7);
+	for (int i = 0; i < 10; ++i) a.engine()();
+	GAGA::RandomStreams b;
+	b.fromJSON(nlohmann::json::parse(a.toJSON().dump()));
+	REQUIRE(b.getSeed() == 7);
+	REQUIRE(b.engine() == a.engine());
+	REQUIRE(b.engine()() == a.engine()());
+	REQUIRE(b.stream(1, 2)() == a.stream(1, 2)());
+}
+
+TEST_CASE("DNA operators receive the GA's random engine", "[random]") {
+	auto a = run(1);
+	REQUIRE(a == run(1));
+	REQUIRE(a != run(2));
+}
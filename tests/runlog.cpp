@@ -0,0 +1,90 @@
+#include "../gaga.hpp"
+#include "dna.hpp"
+#include "catch/catch.hpp"
+
+namespace {
+using Ind = GAGA::Individual<GAGA::RawDNA>;
+
+std::string record(const std::vector<Ind> &pop, int64_t gen) {
+	std::ostringstream os;
+	GAGA::PopulationFile::write(os, pop, "eval", gen);
+	return os.str();
+}
+
+std::vector<Ind> makeInds(size_t n, double f) {
+	std::vector<Ind> res;
+	for (size_t i = 0; i < n; ++i) {
+		res.emplace_back(GAGA::RawDNA("dna" + std::to_string(i)));
+		res.back().fitnesses["f"] = f + static_cast<double>(i);
+	}
+	return res;
+}
+}  // namespace
+
+TEST_CASE("Run logs index their records by generation, kind and objective", "[runlog]") {
+	const std::string dir = "/tmp/gaga_runlog_test";
+	fs::remove_all(dir);
+	fs::create_directories(dir);
+	{
+		GAGA::RunLogWriter w;
+		w.setSegmentSize(1000);
+		w.open(dir);
+		for (size_t g = 0; g < 3; ++g) {
+			w.append(g, GAGA::RunLogKind::population, "", record(makeInds(10, 0.0), static_cast<int64_t>(g)));
+			w.append(g, GAGA::RunLogKind::elites, "f", record(makeInds(2, 100.0 * static_cast<double>(g)), static_cast<int64_t>(g)));
+		}
+	}
+	GAGA::RunLog log(dir);
+	REQUIRE(log.getEntries().size() == 6);
+	REQUIRE(log.getEntries().back().segment > 0);  // small segments
+	auto e = log.find(1, GAGA::RunLogKind::elites);
+	REQUIRE(e.size() == 1);
+	REQUIRE(e[0]->objective == "f");
+	auto elites = log.read(*e[0]);
+	REQUIRE(elites.generation() == 1);
+	REQUIRE(elites.size() == 2);
+	REQUIRE(elites.fitness(1, 0) == 101.0);
+	REQUIRE(log.read(*log.find(2, GAGA::RunLogKind::population, "")[0]).dna(9) == "dna9");
+	REQUIRE(log.find(1, GAGA::RunLogKind::paretoFront).empty());
+
+	// an interrupted append is dropped when the log is reopened
+	std::ofstream(GAGA::RunLogFormat::indexPath(dir), std::ios::app | std::ios::binary) << "xx";
+	{
+		GAGA::RunLogWriter w;
+		w.setSegmentSize(1000);
+		w.open(dir, true);
+		w.append(3, GAGA::RunLogKind::archive, "", record(makeInds(1, 0.0), 3));
+	}
+	log.reload();
+	REQUIRE(log.getEntries().size() == 7);
+	REQUIRE(log.read(*log.find(3, GAGA::RunLogKind::archive)[0]).dna(0) == "dna0");
+}
+
+TEST_CASE("A GA can save in a run log", "[runlog]") {
+	const std::string folder = "/tmp/gaga_runlog_ga_test";
+	fs::remove_all(folder);
+	{
+		GAGA::GA<NullDNA> ga(0, nullptr);
+		ga.setVerbosity(0);
+		ga.setSaveFolder(folder);
+		ga.setSaveGenStats(false);
+		ga.setNbSavedElites(3);
+		ga.enableRunLog();
+		ga.setEvaluator([](auto &i) { i.fitnesses["f"] = 1.0; i.fitnesses["g"] = 2.0; });
+		ga.setPopSize(10);
+		ga.initPopulation([]() { return NullDNA(); });
+		ga.step(2);
+		ga.finish();
+	}
+	std::vector<fs::path> runs;
+	for (const auto &d : fs::directory_iterator(folder)) runs.push_back(d.path());
+	REQUIRE(runs.size() == 1);
+	// index and first segment, no gen folder
+	REQUIRE(std::distance(fs::directory_iterator(runs[0]), fs::directory_iterator()) == 2);
+	GAGA::RunLog log(runs[0].string());
+	REQUIRE(log.find(1, GAGA::RunLogKind::population).size() == 1);
+	auto elites = log.find(1, GAGA::RunLogKind::elites);
+	REQUIRE(elites.size() == 2);
+	REQUIRE(log.read(*elites[1]).size() == 3);
+	REQUIRE(log.read(*elites[1]).objectives() == std::vector<std::string>{"f", "g"});
+}
@@ -0,0 +1,49 @@
+#include "../gaga.hpp"
+#include "catch/catch.hpp"
+
+using Clock = GAGA::EvalScheduler::clock;
+
+TEST_CASE("Lost workers' batches are given to survivors", "[scheduler]") {
+	GAGA::EvalScheduler s(2, 1.0);
+	auto t0 = Clock::now();
+	s.newRound(6, t0);
+	auto b1 = s.assign(1, t0);
+	auto b2 = s.assign(2, t0);
+	auto b3 = s.assign(3, t0);
+	REQUIRE(b1.size() == 2);
+	REQUIRE(s.nbPending() == 0);
+	// worker 1 reports, worker 2 keeps sending heartbeats, worker 3 dies silently
+	auto t1 = t0 + std::chrono::milliseconds(800);
+	REQUIRE(s.complete(1, b1, t1).size() == 2);
+	s.heartbeat(2, t1);
+	auto t2 = t0 + std::chrono::milliseconds(1500);
+	REQUIRE(s.expire(t2) == std::vector<int>{3});
+	REQUIRE(s.nbAlive() == 2);
+	REQUIRE(s.nbPending() == 2);
+	// worker 1 asked for more and gets the dead worker's batch
+	auto b1bis = s.assign(1, t2);
+	REQUIRE(b1bis == b3);
+	s.complete(2, b2, t2);
+	s.complete(1, b1bis, t2);
+	REQUIRE(s.finished());
+}
+
+TEST_CASE("Late results are used once and workers can come back", "[scheduler]") {
+	GAGA::EvalScheduler s(3, 1.0);
+	auto t0 = Clock::now();
+	s.newRound(3, t0);
+	auto b1 = s.assign(1, t0);
+	auto t1 = t0 + std::chrono::seconds(2);
+	REQUIRE(s.expire(t1).size() == 1);
+	REQUIRE(s.nbAlive() == 0);
+	// a new worker joins mid-round and starts on the requeued tasks
+	auto b2 = s.assign(2, t1);
+	REQUIRE(b2 == b1);
+	// worker 1 wasn't dead after all: its results win, worker 2's are duplicates
+	REQUIRE(s.complete(1, b1, t1).size() == 3);
+	REQUIRE(s.isAlive(1));
+	REQUIRE(s.complete(2, b2, t1).empty());
+	REQUIRE(s.finished());
+	REQUIRE(s.assign(2, t1).empty());
+	REQUIRE(s.waitingWorkers().size() == 1);
+}
@@ -0,0 +1,91 @@
+#include "../gaga.hpp"
+#include "dna.hpp"
+#include "catch/catch.hpp"
+
+namespace {
+// rows (i, n - 1 - i) are all on the first front, and they all dominate the other rows
+GAGA::ObjectiveMatrix makeMatrix(size_t n) {
+	std::vector<GAGA::Individual<NullDNA>> pop(2 * n);
+	const double last = static_cast<double>(n - 1);
+	for (size_t i = 0; i < n; ++i) {
+		const double x = static_cast<double>(i);
+		pop[i].fitnesses = {{"a", x}, {"b", last - x}};
+		pop[n + i].fitnesses = {{"a", -1.0 - x}, {"b", -1.0}};
+	}
+	return GAGA::ObjectiveMatrix(pop);
+}
+
+// always the last participant
+struct LastPolicy {
+	static constexpr size_t nbUniforms = 0;
+	static uint32_t winner(const GAGA::ObjectiveMatrix &, const uint32_t *p, size_t k,
+	                       const std::function<bool(double, double)> &, const double *) {
+		return p[k - 1];
+	}
+};
+}  // namespace
+
+TEST_CASE("Tournaments are won by non dominated participants", "[selection]") {
+	auto obj = makeMatrix(10);
+	std::function<bool(double, double)> greater = [](double a, double b) { return a > b; };
+	GAGA::TournamentSelector sel;
+	GAGA::RandomEngine rng(1);
+	std::vector<uint32_t> winners;
+	// large tournaments almost always contain a row of the front, which dominates the others
+	sel.select<GAGA::ParetoTournamentPolicy>(obj, 40, 1000, greater, rng, winners);
+	REQUIRE(winners.size() == 1000);
+	size_t nbFront = 0;
+	for (auto w : winners) nbFront += w < 10;
+	REQUIRE(nbFront == 1000);
+	// on a random objective, the winner is the best row on a or on b
+	sel.select<GAGA::RandomObjTournamentPolicy>(obj, 400, 1000, greater, rng, winners);
+	size_t nbA = 0, nbB = 0;
+	for (auto w : winners) {
+		nbA += w == 9;
+		nbB += w == 0;
+	}
+	REQUIRE(nbA + nbB == 1000);
+	REQUIRE(nbA > 400);
+	REQUIRE(nbB > 400);
+}
+
+TEST_CASE("Tournament winners only depend on the random engine", "[selection]") {
+	auto obj = makeMatrix(50);
+	std::function<bool(double, double)> less = [](double a, double b) { return a < b; };
+	GAGA::TournamentSelector s0, s1;
+	GAGA::RandomEngine r0(3), r1(3);
+	std::vector<uint32_t> w0, w1;
+	s0.select<GAGA::ParetoTournamentPolicy>(obj, 3, 500, less, r0, w0);
+	s1.select<GAGA::ParetoTournamentPolicy>(obj, 3, 500, less, r1, w1, true);
+	REQUIRE(w0 == w1);
+	s0.select<LastPolicy>(obj, 2, 10, less, r0, w0);
+	REQUIRE(w0.size() == 10);
+}
+
+TEST_CASE("A GA accepts custom tournament policies", "[selection]") {
+	GAGA::GA<NullDNA> ga(0, nullptr);
+	quietGA(ga, "/tmp/gaga_selection_test");
+	ga.setSelectionPolicy<LastPolicy>();
+	ga.setEvaluator([](auto &i) { i.fitnesses["f"] = 0.0; });
+	ga.setPopSize(20);
+	ga.initPopulation([]() { return NullDNA(); });
+	ga.step(3);
+	REQUIRE(ga.population.size() == 20);
+}
+
+TEST_CASE("Elites are the best rows of each objective, best first", "[selection]") {
+	auto obj = makeMatrix(10);
+	std::function<bool(double, double)> greater = [](double a, double b) { return a > b; };
+	GAGA::EliteSelector sel;
+	GAGA::EliteSet elites;
+	sel.select(obj, 3, greater, elites);
+	REQUIRE(elites.objectives == std::vector<std::string>{"a", "b"});
+	REQUIRE(elites.rows[0] == std::vector<uint32_t>{9, 8, 7});
+	REQUIRE(elites.rows[1] == std::vector<uint32_t>{0, 1, 2});
+	// ties are broken by row index
+	sel.select(obj, 12, greater, elites);
+	REQUIRE(elites.rows[1][10] == 10);
+	REQUIRE(elites.rows[1][11] == 11);
+	sel.select(obj, 100, greater, elites);
+	REQUIRE(elites.size(0) == 20);
+}
@@ -0,0 +1,79 @@
+#include "../gaga.hpp"
+#include "dna.hpp"
+#include "catch/catch.hpp"
+
+namespace {
+int nbFullCopies = 0;
+int nbPartialCopies = 0;
+
+struct BigDNA {
+	std::vector<int> genes = std::vector<int>(10000, 0);
+	BigDNA() {}
+	BigDNA(const BigDNA &o) : genes(o.genes) { ++nbFullCopies; }
+	BigDNA(BigDNA &&) = default;
+	BigDNA &operator=(const BigDNA &) = default;
+	BigDNA &operator=(BigDNA &&) = default;
+	explicit BigDNA(const std::string &s) : genes(10000, std::stoi(s)) {}
+	void mutate() { ++genes[0]; }
+	void reset() {}
+	BigDNA crossover(const BigDNA &o) {
+		BigDNA child;
+		child.genes[0] = genes[0] + o.genes[0];
+		return child;
+	}
+	void crossover(const BigDNA &o, BigDNA &c0, BigDNA &c1) { c0.genes[0] = c1.genes[0] = genes[0] + o.genes[0]; }
+	std::string serialize() const { return std::to_string(genes[0]); }
+};
+
+struct PartialDNA : BigDNA {
+	using BigDNA::BigDNA;
+	PartialDNA cloneForMutation() const {
+		++nbPartialCopies;
+		PartialDNA d;
+		d.genes[0] = genes[0];
+		return d;
+	}
+};
+}  // namespace
+
+TEST_CASE("Shared DNA is only copied on write", "[dna]") {
+	nbFullCopies = 0;
+	GAGA::SharedDNA<BigDNA> a(std::string("3"));
+	auto b = a;
+	auto c = a;
+	REQUIRE(a.isShared());
+	REQUIRE(nbFullCopies == 0);
+	b.mutate();
+	REQUIRE(nbFullCopies == 1);
+	REQUIRE(b->genes[0] == 4);
+	REQUIRE(a->genes[0] == 3);
+	REQUIRE(!b.isShared());
+	// b owns its body now, a and c still share theirs
+	b.mutate();
+	REQUIRE(nbFullCopies == 1);
+	REQUIRE(c.isShared());
+	auto child = a.crossover(b);
+	REQUIRE(child->genes[0] == 8);
+	REQUIRE(GAGA::SharedDNA<BigDNA>(child.serialize())->genes[0] == 8);
+}
+
+TEST_CASE("cloneForMutation is used to detach shared DNA", "[dna]") {
+	nbFullCopies = nbPartialCopies = 0;
+	GAGA::SharedDNA<PartialDNA> a(std::string("1"));
+	auto b = a;
+	b.mutate();
+	REQUIRE(nbPartialCopies == 1);
+	REQUIRE(nbFullCopies == 0);
+	REQUIRE(b->genes[0] == 2);
+	REQUIRE(a->genes[0] == 1);
+}
+
+TEST_CASE("A GA runs on shared DNA", "[dna]") {
+	GAGA::GA<GAGA::SharedDNA<BigDNA>> ga(0, nullptr);
+	quietGA(ga, "/tmp/gaga_shareddna_test");
+	ga.setEvaluator([](auto &i) { i.fitnesses["value"] = i.dna->genes[0]; });
+	ga.setPopSize(40);
+	ga.initPopulation([]() { return BigDNA(); });
+	ga.step(5);
+	REQUIRE(ga.population.size() == 40);
+}
@@ -0,0 +1,107 @@
+#define SOCKET_WORKERS
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../gaga.hpp"
+#include "dna.hpp"
+#include "catch/catch.hpp"
+
+struct SocketDNA {
+	int value = 0;
+	SocketDNA() {}
+	explicit SocketDNA(const std::string &s) { value = std::stoi(s); }
+	void mutate() { value = (value * 7 + 3) % 1000; }
+	SocketDNA crossover(const SocketDNA &other) {
+		SocketDNA d;
+		d.value = (value + other.value) / 2;
+		return d;
+	}
+	void crossover(const SocketDNA &other, SocketDNA &child0, SocketDNA &child1) {
+		child0 = crossover(other);
+		child1 = child0;
+	}
+	void reset() {}
+	std::string serialize() const { return std::to_string(value); }
+};
+
+// forks a worker process that dies after maxEvals evaluations (0 = never)
+static pid_t startWorker(const std::string &address, int maxEvals) {
+	pid_t pid = fork();
+	if (pid == 0) {
+		GAGA::GA<SocketDNA> worker(0, nullptr);
+		worker.setVerbosity(0);
+		int nbEvals = 0;
+		worker.setEvaluator([&](auto &i) {
+			if (maxEvals > 0 && ++nbEvals > maxEvals) raise(SIGKILL);
+			usleep(1000);
+			i.fitnesses["value"] = i.dna.value * 2;
+		});
+		_exit(worker.runWorker(address) ? 0 : 1);
+	}
+	return pid;
+}
+
+TEST_CASE("Socket workers can join and leave mid-run", "[sockets]") {
+	std::string address = "unix:///tmp/gaga_test_" + std::to_string(getpid()) + ".sock";
+	GAGA::GA<SocketDNA> ga(0, nullptr);
+	quietGA(ga, "/tmp");
+	ga.setEvalBatchSize(4);
+	ga.setWorkerTimeout(5.0);
+	ga.setEvaluator([](auto &i) {
+		usleep(1000);
+		i.fitnesses["value"] = i.dna.value * 2;
+	});
+	ga.enableSocketWorkers(address);
+	ga.setPopSize(100);
+	int n = 0;
+	ga.initPopulation([&]() {
+		SocketDNA d;
+		d.value = n++;
+		return d;
+	});
+	std::vector<pid_t> workers = {startWorker(address, 0), startWorker(address, 30),
+	                              startWorker(address, 0)};
+	ga.step(3);
+	workers.push_back(startWorker(address, 0));  // joins mid-run
+	ga.step(3);
+	REQUIRE(ga.lastGen.size() == 100);
+	for (auto &i : ga.lastGen) {
+		REQUIRE(i.evaluated);
+		REQUIRE(i.fitnesses.at("value") == i.dna.value * 2);
+	}
+	ga.finish();
+	for (size_t w = 0; w < workers.size(); ++w) {
+		int status;
+		waitpid(workers[w], &status, 0);
+		if (w == 1)
+			REQUIRE(WIFSIGNALED(status));
+		else
+			REQUIRE((WIFEXITED(status) && WEXITSTATUS(status) == 0));
+	}
+}
+
+namespace {
+struct ExposedGA : public GAGA::GA<SocketDNA> {
+	ExposedGA() : GAGA::GA<SocketDNA>(0, nullptr) {}
+	bool hasMaster() const { return masterSocket != nullptr; }
+};
+}  // namespace
+
+TEST_CASE("A worker forgets its master when it fails", "[sockets]") {
+	std::string address = "unix:///tmp/gaga_test_throw_" + std::to_string(getpid()) + ".sock";
+	GAGA::Socket listener = GAGA::Socket::listen(address);
+	std::thread master([&]() {
+		GAGA::Socket w = listener.accept();
+		w.send(GAGA::Socket::BATCH, "not a batch");
+		uint32_t type;
+		std::string payload;
+		w.receive(type, payload);  // until the worker is gone
+	});
+	ExposedGA worker;
+	worker.setVerbosity(0);
+	worker.setEvaluator([](auto &i) { i.fitnesses["value"] = 0.0; });
+	REQUIRE_THROWS(worker.runWorker(address));
+	REQUIRE_FALSE(worker.hasMaster());
+	master.join();
+	unlink(address.substr(7).c_str());
+}
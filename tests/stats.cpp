@@ -0,0 +1,159 @@
+#include <atomic>
+#include "../gaga.hpp"
+#include "dna.hpp"
+#include "catch/catch.hpp"
+
+TEST_CASE("The ring buffer keeps the last values", "[stats]") {
+	GAGA::RingBuffer<int> r(3);
+	for (int i = 0; i < 5; ++i) r.push_back(i);
+	REQUIRE(r.size() == 3);
+	REQUIRE(r.firstIndex() == 2);
+	REQUIRE(r[2] == 2);
+	REQUIRE(r.back() == 4);
+	REQUIRE_THROWS_AS(r.at(1), std::out_of_range);
+	r.setCapacity(2);
+	REQUIRE(r.firstIndex() == 3);
+	REQUIRE(r.at(3) == 3);
+	r.push_back(5);
+	REQUIRE(r.at(4) == 4);
+	REQUIRE(r.at(5) == 5);
+	r.reset(10);
+	r.push_back(10);
+	REQUIRE(r.at(10) == 10);
+}
+
+TEST_CASE("Gen stats are appended, with a new header for new columns", "[stats]") {
+	const std::string path = "/tmp/gaga_gen_stats_test.csv";
+	{
+		GAGA::GenStatsWriter w;
+		w.open(path);
+		w.write(0, {{"global", {{"t", 1.0}}}, {"obj0", {{"best", 2.0}}}});
+		w.write(1, {{"global", {{"t", 3.0}}}});
+		w.write(2, {{"global", {{"t", 4.0}}}, {"obj1", {{"best", 5.0}}}});
+	}
+	std::ifstream f(path);
+	std::stringstream content;
+	content << f.rdbuf();
+	REQUIRE(content.str() ==
+	        "generation,global_t,obj0_best\n"
+	        "0,1,2\n"
+	        "1,3,\n"
+	        "generation,global_t,obj0_best,obj1_best\n"
+	        "2,4,,5\n");
+
+	// a resumed run drops the rows of the generations it computes again
+	{
+		GAGA::GenStatsWriter w;
+		w.open(path, true, 2);
+		w.write(2, {{"global", {{"t", 6.0}}}});
+	}
+	std::ifstream resumed(path);
+	std::stringstream resumedContent;
+	resumedContent << resumed.rdbuf();
+	REQUIRE(resumedContent.str() ==
+	        "generation,global_t,obj0_best\n"
+	        "0,1,2\n"
+	        "1,3,\n"
+	        "generation,global_t\n"
+	        "2,6\n");
+}
+
+TEST_CASE("Saving jobs run in order, with a bounded queue", "[stats]") {
+	GAGA::AsyncWriter w;
+	w.setEnabled(true);
+	w.setMaxPending(1);
+	std::vector<int> done;
+	std::atomic<bool> release(false);
+	w.submit([&]() {
+		while (!release) std::this_thread::yield();
+		done.push_back(0);
+	});
+	w.submit([&]() { done.push_back(1); });
+	// the queue is full: this one waits for room, so it is submitted from another thread
+	std::thread t([&]() { w.submit([&]() { done.push_back(2); }); });
+	release = true;
+	t.join();
+	w.drain();
+	REQUIRE(done == std::vector<int>{0, 1, 2});
+	w.setEnabled(false);
+	w.submit([&]() { done.push_back(3); });
+	REQUIRE(done.size() == 4);
+}
+
+TEST_CASE("Failed saves reach the caller", "[stats]") {
+	GAGA::AsyncWriter w;
+	auto fail = []() { throw std::runtime_error("disk full"); };
+	REQUIRE_THROWS_AS(w.submit(fail), std::runtime_error);
+	// on the I/O thread, the first failure is rethrown once the jobs are done
+	w.setEnabled(true);
+	bool ran = false;
+	w.submit(fail);
+	w.submit([&]() { ran = true; });
+	REQUIRE_THROWS_AS(w.drain(), std::runtime_error);
+	REQUIRE(ran);
+	w.drain();
+	w.submit(fail);
+	w.stop();
+	REQUIRE_THROWS_AS(w.rethrow(), std::runtime_error);
+}
+
+TEST_CASE("Individual stats are appended as columnar blocks", "[stats]") {
+	const std::string path = "/tmp/gaga_ind_stats_test.bin";
+	std::vector<GAGA::Individual<int>> pop(3);
+	for (size_t i = 0; i < pop.size(); ++i) {
+		const double x = static_cast<double>(i);
+		pop[i].fitnesses = {{"a", x}, {"b", -0.5 * x}};
+	}
+	GAGA::ObjectiveMatrix obj(pop);
+	std::vector<bool> onFront{true, false, true};
+	std::vector<double> times{0.0, 0.25, 0.5};
+	{
+		GAGA::IndStatsWriter w;
+		w.open(path);
+		w.write(0, obj, onFront, times);
+		w.write(1, obj, onFront, times);
+	}
+	// an interrupted write leaves an incomplete block, which is dropped when appending
+	const auto size = fs::file_size(path);
+	fs::resize_file(path, size - 5);
+	std::vector<GAGA::IndStatsBlock> blocks;
+	auto collect = [&](GAGA::IndStatsBlock &&b) { blocks.push_back(std::move(b)); };
+	GAGA::IndStatsFormat::read(path, collect);
+	REQUIRE(blocks.size() == 1);
+	{
+		GAGA::IndStatsWriter w;
+		w.open(path, true);
+		w.write(2, obj, onFront, times);
+	}
+	blocks.clear();
+	REQUIRE(GAGA::IndStatsFormat::read(path, collect) == size);
+	REQUIRE(blocks.size() == 2);
+	const auto &b = blocks[1];
+	REQUIRE(b.generation == 2);
+	REQUIRE(b.objectives == std::vector<std::string>{"a", "b"});
+	REQUIRE(b.fitnesses[1] == std::vector<double>{0.0, -0.5, -1.0});
+	REQUIRE(b.evalTimes == times);
+	REQUIRE(b.ids == std::vector<uint32_t>{0, 1, 2});
+	REQUIRE(b.onParetoFront == std::vector<uint8_t>{1, 0, 1});
+}
+
+// the header used to be written once per process
+TEST_CASE("Each GA writes its own individual stats", "[stats]") {
+	for (int run = 0; run < 2; ++run) {
+		const std::string folder = "/tmp/gaga_ind_stats_test" + std::to_string(run);
+		fs::remove_all(folder);
+		GAGA::GA<NullDNA> ga(0, nullptr);
+		quietGA(ga, folder);
+		ga.setSaveIndStats(true);
+		ga.setEvaluator([](auto &i) { i.fitnesses["f"] = 1.0; });
+		ga.setPopSize(10);
+		ga.initPopulation([]() { return NullDNA(); });
+		ga.step(3);
+		ga.finish();
+		size_t nbBlocks = 0;
+		for (const auto &d : fs::directory_iterator(folder))
+			GAGA::IndStatsFormat::read(d.path().string() + "/ind_stats.bin",
+			                           [&](GAGA::IndStatsBlock &&b) { nbBlocks += b.ids.size() == 10; });
+		REQUIRE(nbBlocks == 3);
+	}
+}
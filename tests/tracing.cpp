@@ -0,0 +1,78 @@
+// built as gaga_tracing_test (see CMakeLists.txt), since TRACING changes gaga.hpp's
+// inline functions
+#define TRACING
+#include "../gaga.hpp"
+#include "catch/catch.hpp"
+
+namespace {
+struct TracedDNA {
+	TracedDNA() {}
+	explicit TracedDNA(const std::string &) {}
+	void mutate() {}
+	TracedDNA crossover(const TracedDNA &) { return *this; }
+	void crossover(const TracedDNA &, TracedDNA &, TracedDNA &) {}
+	void reset() {}
+	std::string serialize() const { return ""; }
+};
+
+std::map<std::string, size_t> countSpans(const nlohmann::json &trace) {
+	std::map<std::string, size_t> res;
+	for (const auto &e : trace.at("traceEvents"))
+		if (e.at("ph") == "X") ++res[e.at("name").get<std::string>()];
+	return res;
+}
+}  // namespace
+
+TEST_CASE("Spans are recorded per thread as Chrome trace events", "[tracing]") {
+	auto &tracer = GAGA::Tracer::get();
+	tracer.clear();
+	{ GAGA_TRACE_SPAN("outer"); }
+	std::thread t([]() {
+		GAGA::Tracer::get().setThreadName("helper");
+		GAGA_TRACE_SPAN("inner");
+	});
+	t.join();
+	REQUIRE(tracer.size() == 2);
+	std::stringstream doc;
+	GAGA::Tracer::writeDocument(doc, {tracer.events()});
+	auto trace = nlohmann::json::parse(doc.str());
+	std::map<std::string, int> tids;
+	bool named = false;
+	for (const auto &e : trace.at("traceEvents")) {
+		if (e.at("ph") == "X") {
+			REQUIRE(e.at("dur").get<double>() >= 0.0);
+			tids[e.at("name")] = e.at("tid");
+		}
+		named = named || (e.at("name") == "thread_name" && e.at("args").at("name") == "helper");
+	}
+	REQUIRE(tids.size() == 2);
+	REQUIRE(tids["outer"] != tids["inner"]);
+	REQUIRE(named);
+	tracer.clear();
+	REQUIRE(tracer.size() == 0);
+}
+
+TEST_CASE("A GA writes the trace of its phases", "[tracing]") {
+	const std::string folder = "/tmp/gaga_tracing_test";
+	fs::remove_all(folder);
+	GAGA::Tracer::get().clear();
+	GAGA::GA<TracedDNA> ga(0, nullptr);
+	ga.setVerbosity(0);
+	ga.setSaveFolder(folder);
+	ga.setSaveGenStats(false);
+	ga.setEvaluator([](auto &i) { i.fitnesses["f"] = 1.0; });
+	ga.setPopSize(20);
+	ga.initPopulation([]() { return TracedDNA(); });
+	ga.step(3);
+	ga.finish();
+	std::vector<fs::path> runs;
+	for (const auto &d : fs::directory_iterator(folder)) runs.push_back(d.path());
+	REQUIRE(runs.size() == 1);
+	std::ifstream file((runs[0] / "trace.json").string());
+	auto spans = countSpans(nlohmann::json::parse(file));
+	REQUIRE(spans["generation"] == 3);
+	REQUIRE(spans["evaluation"] == 3);
+	REQUIRE(spans["breeding"] == 3);
+	REQUIRE(spans["savePop"] == 3);
+	REQUIRE(spans["saveBests"] == 3);
+}
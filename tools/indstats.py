@@ -0,0 +1,90 @@
+#!/usr/bin/python3
+"""Reads the per individual stats of a run (ind_stats.bin, see IndStatsFormat in gaga.hpp).
+Only needs the standard library: columns are array.array, which numpy.frombuffer can wrap
+without a copy.
+
+    import indstats
+    for block in indstats.read('evos/run/ind_stats.bin'):
+        print(block['generation'], max(block['fitnesses']['obj0']))
+
+As a script, prints the stats as csv: indstats.py ind_stats.bin > ind_stats.csv
+"""
+
+import array
+import struct
+import sys
+import zlib
+
+MAGIC = b'GAGAIST\0'
+VERSION = 1
+BYTE_ORDER_MARK = 0x01020304
+RAW, DEFLATED = 0, 1
+
+
+def _column(payload, pos, typecode, n, swap):
+    pos = (pos + 7) // 8 * 8
+    col = array.array(typecode)
+    size = n * col.itemsize
+    col.frombytes(payload[pos:pos + size])
+    if swap:
+        col.byteswap()
+    return col, pos + size
+
+
+def read(path):
+    """Yields the blocks of a file, one per generation, as dicts: generation, objectives,
+    fitnesses (objective name -> column), evalTime, id and onParetoFront (columns).
+    An incomplete last block (interrupted run) is ignored."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != MAGIC:
+        raise ValueError(path + ' is not an individual stats file')
+    order = '<' if struct.unpack_from('<I', data, 12)[0] == BYTE_ORDER_MARK else '>'
+    swap = (order == '<') != (sys.byteorder == 'little')
+    if struct.unpack_from(order + 'I', data, 8)[0] > VERSION:
+        raise ValueError(path + ' was written by a newer version of gaga')
+    pos = 16
+    while pos + 40 <= len(data):
+        size, gen, n, nb_obj, encoding, raw_size = struct.unpack_from(order + 'QQQIIQ', data, pos)
+        pos += 40
+        if pos + size > len(data):
+            break
+        payload = data[pos:pos + size]
+        pos += size
+        if encoding == DEFLATED:
+            payload = zlib.decompress(payload)
+        p = 0
+        names = []
+        for _ in range(nb_obj):
+            (length,) = struct.unpack_from(order + 'Q', payload, p)
+            names.append(payload[p + 8:p + 8 + length].decode())
+            p += 8 + length
+        block = {'generation': gen, 'objectives': names, 'fitnesses': {}}
+        for name in names:
+            block['fitnesses'][name], p = _column(payload, p, 'd', n, swap)
+        block['evalTime'], p = _column(payload, p, 'd', n, swap)
+        block['id'], p = _column(payload, p, 'I', n, swap)
+        block['onParetoFront'], p = _column(payload, p, 'B', n, swap)
+        yield block
+
+
+def to_csv(path, out=sys.stdout):
+    """Writes the stats in the layout of the former ind_stats.csv, with a header line each
+    time the objectives change."""
+    objectives = None
+    for b in read(path):
+        if b['objectives'] != objectives:
+            objectives = b['objectives']
+            out.write(','.join(['generation', 'idInd'] + objectives + ['isOnParetoFront', 'time']))
+            out.write('\n')
+        columns = [b['fitnesses'][o] for o in objectives]
+        for i in range(len(b['id'])):
+            row = [b['generation'], b['id'][i]] + [c[i] for c in columns]
+            row += [b['onParetoFront'][i], b['evalTime'][i]]
+            out.write(','.join(str(v) for v in row) + '\n')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        sys.exit('usage: indstats.py ind_stats.bin')
+    to_csv(sys.argv[1])
@@ -0,0 +1,35 @@
+// Converts population saves between the binary format (.gpop) and json (.pop).
+// The direction is given by the input file: binary files are exported to json,
+// anything else is parsed as json and written as a binary file.
+//   popconvert pop12.gpop pop12.pop
+//   popconvert pop12.pop pop12.gpop
+#include <iostream>
+#include "../gaga.hpp"
+
+int main(int argc, char **argv) {
+	if (argc != 3) {
+		std::cerr << "usage: " << argv[0] << " <input> <output>" << std::endl;
+		return 1;
+	}
+	const std::string in = argv[1], out = argv[2];
+	try {
+		if (GAGA::PopulationFile::isPopulationFile(in)) {
+			GAGA::PopulationFile pf(in);
+			std::ofstream file(out);
+			pf.writeJSON(file);
+			if (!file) throw std::runtime_error("Cannot write " + out);
+		} else {
+			std::ifstream file(in);
+			if (!file) throw std::runtime_error("Cannot open " + in);
+			nlohmann::json o;
+			auto pop = GAGA::Individual<GAGA::RawDNA>::loadPopFromJSON(file, &o);
+			std::string evaluator = o.count("evaluator") ? o.at("evaluator").get<std::string>() : "";
+			int64_t generation = o.count("generation") ? o.at("generation").get<int64_t>() : -1;
+			GAGA::PopulationFile::write(out, pop, evaluator, generation);
+		}
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
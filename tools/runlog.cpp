@@ -0,0 +1,59 @@
+// Lists or extracts the records of a run log (see GAGA::RunLog).
+//   runlog <run folder> list
+//   runlog <run folder> extract <generation> <population|archive|elites|paretoFront>
+//          [objective] > records.json
+// extract prints a json array of population documents (one per matching record: e.g.
+// one per objective for elites), in the format of json population saves.
+#include <iostream>
+#include "../gaga.hpp"
+
+int main(int argc, char **argv) {
+	const std::string usage = std::string("usage: ") + argv[0] +
+	                          " <run folder> list | extract <generation> <kind> [objective]";
+	if (argc < 3) {
+		std::cerr << usage << std::endl;
+		return 1;
+	}
+	try {
+		GAGA::RunLog log(argv[1]);
+		const std::string cmd = argv[2];
+		if (cmd == "list") {
+			for (const auto &e : log.getEntries()) {
+				std::cout << e.generation << "\t" << GAGA::runLogKindName(e.kind) << "\t"
+				          << (e.objective.empty() ? "-" : e.objective) << "\t" << log.read(e).size()
+				          << " individuals\t(segment " << e.segment << ", " << e.size << " bytes)"
+				          << std::endl;
+			}
+		} else if (cmd == "extract" && (argc == 5 || argc == 6)) {
+			const size_t gen = std::stoul(argv[3]);
+			const std::string kindName = argv[4];
+			GAGA::RunLogKind kind = GAGA::RunLogKind::population;
+			bool found = false;
+			for (auto k : {GAGA::RunLogKind::population, GAGA::RunLogKind::archive,
+			               GAGA::RunLogKind::elites, GAGA::RunLogKind::paretoFront}) {
+				if (kindName == GAGA::runLogKindName(k)) {
+					kind = k;
+					found = true;
+				}
+			}
+			if (!found) throw std::invalid_argument("Unknown kind " + kindName);
+			std::cout << "[";
+			bool first = true;
+			for (auto e : log.find(gen, kind, argc == 6 ? argv[5] : "*")) {
+				nlohmann::json header = nlohmann::json::object();
+				if (!e->objective.empty()) header["objective"] = e->objective;
+				if (!first) std::cout << ",";
+				first = false;
+				log.read(*e).writeJSON(std::cout, header);
+			}
+			std::cout << "]" << std::endl;
+		} else {
+			std::cerr << usage << std::endl;
+			return 1;
+		}
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}